@@ -16,7 +16,18 @@ class actuator2D : virtual public joint2D
   public:
     bool is_actuator() const override final;
 
+    // force applied to body2 (body1 receives the opposite) and the torques it induces on each body
+    struct wrench
+    {
+        glm::vec2 force;
+        float torque1;
+        float torque2;
+    };
+
     void solve(std::vector<state2D> &states);
+    // same as solve, but without writing to the states. safe to run concurrently with other actuators
+    wrench compute_wrench(const std::vector<state2D> &states);
+
     virtual glm::vec3 compute_force(const state2D &state1, const state2D &state2) const = 0;
 
     glm::vec2 reactive_force() const override final;
@@ -12,6 +12,7 @@ class actuator_meta_manager2D final : public joint_meta_manager2D<iactuator_mana
     icontact_actuator_manager2D *m_contact_solver = nullptr;
 
     void solve(std::vector<state2D> &states);
+    void solve_contacts(std::vector<state2D> &states);
     friend class world2D;
     friend class collision_manager2D;
 };
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ppx/body/state.hpp"
+#include <array>
+
+namespace ppx
+{
+// Quadtree over a set of states in which every cell summarizes the states it holds as a single pseudo state, with
+// their total mass and charge placed at their centers of mass and charge. Pair interactions with far away cells are
+// evaluated against that pseudo state (Barnes-Hut). A cell is far away when its size over its distance to the queried
+// state is below the opening angle, so an opening angle of zero reproduces the exact sum. Cells with charges of mixed
+// sign are only approximated by their net charge, which loses accuracy for electrostatics with both signs
+class barnes_hut_tree2D
+{
+  public:
+    static inline constexpr std::uint32_t MAX_DEPTH = 24;
+
+    // the states must outlive the tree, or at least the queries made before the next build
+    void build(const std::vector<const state2D *> &states, std::uint32_t leaf_capacity);
+
+    // sums pair(state, other) for every other state in the tree, or for the pseudo state of a far cell holding it
+    template <typename T, typename Pair>
+    T accumulate(const state2D &state, const float opening_angle, Pair &&pair) const
+    {
+        T total{0.f};
+        if (m_nodes.empty())
+            return total;
+
+        const glm::vec2 &position = state.centroid.position;
+        const float angle2 = opening_angle * opening_angle;
+
+        std::array<std::uint32_t, 3 * MAX_DEPTH + 4> stack;
+        std::size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+            const node &nd = m_nodes[stack[--size]];
+            if (nd.begin == nd.end)
+                continue;
+            if (nd.children == 0)
+            {
+                for (std::uint32_t i = nd.begin; i < nd.end; i++)
+                    if (m_states[i] != &state)
+                        total += pair(state, *m_states[i]);
+                continue;
+            }
+
+            const glm::vec2 dist = position - nd.aggregate.centroid.position;
+            const float cell = 2.f * nd.half_size;
+            if (!nd.contains(position) && cell * cell < angle2 * glm::dot(dist, dist))
+            {
+                total += pair(state, nd.aggregate);
+                continue;
+            }
+            for (std::uint32_t i = 0; i < 4; i++)
+                stack[size++] = nd.children + i;
+        }
+        return total;
+    }
+
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    struct node
+    {
+        glm::vec2 center;
+        float half_size;
+        std::uint32_t begin;
+        std::uint32_t end;
+        std::uint32_t children = 0; // first of four consecutive nodes. the root is never a child, so 0 means a leaf
+        state2D aggregate;
+
+        bool contains(const glm::vec2 &point) const;
+    };
+
+    std::vector<const state2D *> m_states;
+    std::vector<node> m_nodes;
+    std::uint32_t m_leaf_capacity = 1;
+
+    void subdivide(std::uint32_t index, std::uint32_t depth);
+    void aggregate(node &nd) const;
+};
+} // namespace ppx
@@ -41,7 +41,7 @@ class behaviour2D : public manager2D<body2D>,
 #endif
 
   private:
-    void load_forces(std::vector<state2D> &states) const;
+    virtual void load_forces(std::vector<state2D> &states) const;
 
     friend class behaviour_manager2D;
 };
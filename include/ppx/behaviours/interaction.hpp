@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ppx/behaviours/behaviour.hpp"
+#include "ppx/behaviours/barnes_hut_tree.hpp"
 
 namespace ppx
 {
@@ -10,6 +11,9 @@ class interaction2D : public behaviour2D
     interaction2D(world2D &world, const std::string &name);
     virtual ~interaction2D() = default;
 
+    // with multithreading on, force_pair is called concurrently for different bodies and must be thread safe. in barnes
+    // hut mode, state2 may be the pseudo state of a far cell, with only its mass, charge, centroid position and
+    // charge centroid set. the same goes for state2 in potential_energy_pair
     virtual glm::vec3 force_pair(const state2D &state1, const state2D &state2) const = 0;
 
     glm::vec3 force(const state2D &state) const override final;
@@ -27,7 +31,15 @@ class interaction2D : public behaviour2D
     float potential_energy(const state2D &state) const override final;
     float potential_energy() const override final;
 
+    specs::interaction2D params;
+
   private:
     mutable state2D m_unit;
+
+    // rebuilt whenever forces or the total potential energy are computed in barnes hut mode
+    mutable barnes_hut_tree2D m_tree;
+    mutable std::vector<const state2D *> m_sources;
+
+    void load_forces(std::vector<state2D> &states) const override;
 };
 } // namespace ppx
@@ -39,12 +39,20 @@ class body2D final : public worldref2D, kit::non_copyable
     {
         std::size_t index;
         island2D *island = nullptr;
-        bool island_flag = false;
+        std::size_t island_slot = 0;
+        std::uint32_t island_epoch = 0; // visited by the island flood fill of that epoch
 
+        // joints and contacts store their position in these vectors, so adding and removing is O(1) (swap and pop)
         std::vector<joint2D *> joints;
         std::vector<contact2D *> contacts;
+        void add_joint(joint2D *joint);
+        void add_contact(contact2D *contact);
         void remove_joint(const joint2D *joint);
         void remove_contact(const contact2D *contact);
+
+      private:
+        std::size_t &slot(joint2D *joint) const;
+        std::size_t slot(const joint2D *joint) const;
     } meta; // easy read & write data
 
     const collider2D *operator[](std::size_t index) const;
@@ -145,6 +153,12 @@ class body2D final : public worldref2D, kit::non_copyable
     float charge() const;
     void charge(float charge);
 
+    float sleep_velocity_threshold() const;
+    void sleep_velocity_threshold(float threshold);
+
+    float sleep_angular_velocity_threshold() const;
+    void sleep_angular_velocity_threshold(float threshold);
+
     void centroid(const glm::vec2 &centroid);
     void gposition(const glm::vec2 &gposition);
     void origin(const glm::vec2 &origin);
@@ -175,6 +189,8 @@ class body2D final : public worldref2D, kit::non_copyable
 
     float m_instant_torque = 0.f;
     float m_persistent_torque = 0.f;
+    float m_sleep_velocity_threshold = 0.f;
+    float m_sleep_angular_velocity_threshold = 0.f;
 
     std::vector<collider2D *> m_colliders;
 
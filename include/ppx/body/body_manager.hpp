@@ -32,8 +32,11 @@ class body_manager2D final : public manager2D<body2D>
   private:
     using manager2D<body2D>::manager2D;
 
+    void sort_by_island();
     void gather_and_load_states(rk::state<float> &rkstate);
+    void load_states(rk::state<float> &rkstate) const;
     void update_states(const std::vector<float> &posvels);
+    void reset_substep_forces();
 
     void integrate_velocities(float ts);
     void integrate_positions(float ts);
@@ -44,6 +47,7 @@ class body_manager2D final : public manager2D<body2D>
     std::vector<state2D> &mutable_states();
 
     std::vector<state2D> m_states;
+    std::vector<body2D *> m_sorted;
 
     friend class world2D;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ppx/body/body.hpp"
+#include "ppx/collision/material.hpp"
 #include "kit/interface/non_copyable.hpp"
 #include "kit/events/event.hpp"
 #include <variant>
@@ -16,24 +17,15 @@ class collider2D final : public worldref2D, kit::non_copyable
 
     collider2D(world2D &world, body2D *body, const specs &spc = {});
 
-    float restitution;
-    float friction;
     filter collision_filter;
 
     struct metadata
     {
         std::size_t index;
+        std::uint32_t id = 0; // never reused, unlike the index, which shifts when colliders are removed
         bool broad_flag = false;
     } meta;
 
-    struct
-    {
-        kit::event<contact2D *> on_contact_enter;
-        kit::event<contact2D *> on_contact_pre_solve;
-        kit::event<contact2D *> on_contact_post_solve;
-        kit::event<contact2D &> on_contact_exit;
-    } events;
-
     stype shape_type() const;
 
     const geo::aabb2D &tight_bbox() const;
@@ -44,6 +36,9 @@ class collider2D final : public worldref2D, kit::non_copyable
 
     float area() const;
     float inertia() const;
+    float radius() const;
+
+    const kit::dynarray<glm::vec2, PPX_MAX_VERTICES> &lnormals() const;
 
     bool is_circle() const;
     bool is_polygon() const;
@@ -54,6 +49,18 @@ class collider2D final : public worldref2D, kit::non_copyable
     float charge_density() const;
     void charge_density(float charge_density);
 
+    float restitution() const;
+    void restitution(float restitution);
+
+    float friction() const;
+    void friction(float friction);
+
+    // see material_table2D. 0 (or an unknown id) combines the collider's own restitution and friction
+    std::uint32_t material() const;
+    void material(std::uint32_t material);
+
+    const surface2D &surface() const;
+
     void begin_update();
     void end_update();
 
@@ -99,6 +106,7 @@ class collider2D final : public worldref2D, kit::non_copyable
             m_type = stype::POLYGON;
         else if constexpr (std::is_same_v<T, circle>)
             m_type = stype::CIRCLE;
+        update_local_data();
         m_body->full_update();
     }
 
@@ -114,10 +122,18 @@ class collider2D final : public worldref2D, kit::non_copyable
     body2D *m_body;
     float m_density;
     float m_charge_density;
+    surface2D m_surface;
+    std::uint32_t m_material;
 
     stype m_type;
 
+    // edge normals in the body frame (only rotated by the body when queried) and bounding radius. they depend
+    // solely on the local geometry, so they are rebuilt on local rotations or shape changes, never per step
+    kit::dynarray<glm::vec2, PPX_MAX_VERTICES> m_lnormals;
+    float m_radius = 0.f;
+
     void gtranslate_shape(const glm::vec2 &dpos);
+    void update_local_data();
 
     template <typename F> auto call_shape_method(F &&f) -> std::invoke_result_t<F, shape2D &>
     {
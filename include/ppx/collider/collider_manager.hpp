@@ -30,5 +30,6 @@ class collider_manager2D final : public manager2D<collider2D>
 
   private:
     using manager2D<collider2D>::manager2D;
+    std::uint32_t m_next_id = 0;
 };
 } // namespace ppx
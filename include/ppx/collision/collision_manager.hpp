@@ -7,7 +7,10 @@
 #include "ppx/collision/broad/quad_tree_broad.hpp"
 #include "ppx/collision/broad/brute_force_broad.hpp"
 #include "ppx/collision/narrow/narrow_phase.hpp"
+#include "ppx/collision/material.hpp"
 #include "ppx/internal/worldref.hpp"
+#include <functional>
+#include <span>
 
 namespace ppx
 {
@@ -22,12 +25,17 @@ class collision_manager2D final : public worldref2D, public kit::toggleable
   public:
     struct
     {
-        kit::event<contact2D *> on_contact_enter;
-        kit::event<contact2D *> on_contact_pre_solve;
-        kit::event<contact2D *> on_contact_post_solve;
-        kit::event<contact2D &> on_contact_exit;
+        // fired once after every step with all contact records of that step. contacts only record events while this
+        // has subscribers, so that listener-free worlds pay nothing
+        contact_event_signal2D on_contact_events;
     } events;
 
+    // called once per step for every active contact, right after detection. returning false disables the contact
+    // for the step. leave empty unless contacts need to be vetoed
+    std::function<bool(contact2D *)> pre_solve_filter;
+
+    material_table2D materials;
+
     template <kit::DerivedFrom<broad_phase2D> T = broad_phase2D> const T *broad() const
     {
         return kit::get_casted_raw_ptr<const T>(m_broad, m_known_broads);
@@ -117,6 +125,7 @@ class collision_manager2D final : public worldref2D, public kit::toggleable
     void set_constraint_based_contact_manager(icontact_constraint_manager2D *contacts);
     void set_actuator_based_contact_manager(icontact_actuator_manager2D *contacts);
     void detect_and_create_contacts();
+    void deliver_contact_events();
     friend class world2D;
 };
 } // namespace ppx
@@ -4,7 +4,6 @@
 #include "ppx/collision/collision.hpp"
 #include "ppx/constraints/pvconstraint.hpp"
 #include "ppx/actuators/actuator.hpp"
-#include "kit/container/hashable_tuple.hpp"
 
 namespace ppx
 {
@@ -26,9 +25,18 @@ concept Contact2D = ContactConstraint2D<T> || ContactActuator2D<T>;
 class contact2D : virtual public joint2D
 {
   public:
-    using contact_key = kit::non_commutative_tuple<const collider2D *, const collider2D *, std::uint32_t>;
+    // collider ids packed into 64 bits plus the manifold feature id. ids are never reused, so keys never go stale
+    struct contact_key
+    {
+        std::uint64_t colliders = 0;
+        std::uint32_t feature = 0;
+
+        bool operator==(const contact_key &) const = default;
+    };
     virtual ~contact2D() = default;
 
+    static contact_key make_key(const collider2D *collider1, const collider2D *collider2, std::uint32_t feature);
+
     collider2D *collider1() const; // what about non const?
     collider2D *collider2() const;
 
@@ -39,17 +47,20 @@ class contact2D : virtual public joint2D
     float restitution() const;
     float friction() const;
 
+    // impulses applied by the contact during the last solve, split along its normal and tangent
+    virtual float normal_impulse() const;
+    virtual float tangent_impulse() const;
+
     void increment_age();
     bool recently_updated() const;
     bool expired() const;
     bool asleep() const;
     std::uint32_t life_expectancy() const;
+    std::uint32_t age() const;
 
     void on_enter();
-    void on_exit();
-
-    void on_pre_solve();
-    void on_post_solve();
+    void on_exit(const collider2D *removed = nullptr);
+    bool just_entered() const;
 
     bool is_contact() const override final; // remove this and from joint as well
 
@@ -69,5 +80,10 @@ class contact2D : virtual public joint2D
 
     float m_restitution;
     float m_friction;
+
+    bool m_just_entered = false;
+    bool m_reported = false; // a BEGIN record was emitted and its END is still owed
+
+    friend class icontact_manager2D;
 };
 } // namespace ppx
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ppx/common/alias.hpp"
+#include "kit/events/event.hpp"
+#include <cstdint>
+#include <span>
+
+namespace ppx
+{
+class collider2D;
+
+// A record of what happened to a contact point during a step. Records are buffered by the contact manager and handed
+// to listeners in a single batch once the step is finished. BEGIN and PERSIST records carry the impulse the contact
+// applied during the last solve. END records may outlive their contact, so they only keep the colliders involved,
+// and a collider pointer is null if that collider was removed from the world
+struct contact_event2D
+{
+    enum class etype : std::uint8_t
+    {
+        BEGIN = 0,
+        PERSIST = 1,
+        END = 2
+    };
+
+    etype type;
+    collider2D *collider1;
+    collider2D *collider2;
+    std::uint32_t feature;
+
+    glm::vec2 point;
+    glm::vec2 normal;
+    float normal_impulse;
+    float tangent_impulse;
+};
+
+// Event that keeps count of its subscribers, so that contacts only record events while someone is listening
+class contact_event_signal2D final : public kit::event<std::span<const contact_event2D>>
+{
+  public:
+    using base = kit::event<std::span<const contact_event2D>>;
+
+    template <typename Callback> contact_event_signal2D &operator+=(Callback &&callback)
+    {
+        base::operator+=(std::forward<Callback>(callback));
+        m_subscribers++;
+        return *this;
+    }
+    template <typename Callback> contact_event_signal2D &operator-=(Callback &&callback)
+    {
+        base::operator-=(std::forward<Callback>(callback));
+        if (m_subscribers > 0)
+            m_subscribers--;
+        return *this;
+    }
+
+    bool has_subscribers() const
+    {
+        return m_subscribers > 0;
+    }
+
+  private:
+    std::size_t m_subscribers = 0;
+};
+} // namespace ppx
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+
+#ifndef PPX_NO_SIMD
+#if defined(__x86_64__) || defined(_M_X64)
+#define PPX_SIMD_X86
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define PPX_SIMD_NEON
+#endif
+#endif
+
+namespace ppx
+{
+// A group of independent contact rows laid out lane by lane, so that a whole group can be solved with one SIMD
+// instruction per operation. Rows in a group must not share a dynamic body. Non-dynamic bodies are expected to have
+// zero inverse mass and inertia, and rows without friction zero tangent mass. After solving, (px, py) holds the total
+// impulse applied to body 2 during the pass (body 1 receives the opposite)
+struct contact_lanes2D
+{
+    static inline constexpr std::size_t MAX_WIDTH = 8;
+
+    alignas(32) float v1x[MAX_WIDTH];
+    alignas(32) float v1y[MAX_WIDTH];
+    alignas(32) float w1[MAX_WIDTH];
+    alignas(32) float v2x[MAX_WIDTH];
+    alignas(32) float v2y[MAX_WIDTH];
+    alignas(32) float w2[MAX_WIDTH];
+
+    alignas(32) float nx[MAX_WIDTH];
+    alignas(32) float ny[MAX_WIDTH];
+    alignas(32) float r1x[MAX_WIDTH];
+    alignas(32) float r1y[MAX_WIDTH];
+    alignas(32) float r2x[MAX_WIDTH];
+    alignas(32) float r2y[MAX_WIDTH];
+
+    alignas(32) float imass1[MAX_WIDTH];
+    alignas(32) float imass2[MAX_WIDTH];
+    alignas(32) float iinertia1[MAX_WIDTH];
+    alignas(32) float iinertia2[MAX_WIDTH];
+
+    alignas(32) float normal_mass[MAX_WIDTH];
+    alignas(32) float tangent_mass[MAX_WIDTH];
+    alignas(32) float bias[MAX_WIDTH];
+    alignas(32) float mass_scale[MAX_WIDTH];
+    alignas(32) float impulse_scale[MAX_WIDTH];
+    alignas(32) float friction[MAX_WIDTH];
+
+    alignas(32) float normal_impulse[MAX_WIDTH];
+    alignas(32) float tangent_impulse[MAX_WIDTH];
+
+    alignas(32) float px[MAX_WIDTH];
+    alignas(32) float py[MAX_WIDTH];
+};
+
+struct contact_lanes_kernel2D
+{
+    void (*solve)(contact_lanes2D &lanes) = nullptr;
+    std::size_t width = 0; // 0 when no SIMD kernel is available
+    const char *name = "Scalar";
+};
+
+// widest kernel supported by the running CPU, detected once
+const contact_lanes_kernel2D &contact_lanes_kernel();
+
+#ifdef PPX_SIMD_X86
+void solve_contact_lanes_avx2(contact_lanes2D &lanes); // only call if the CPU supports AVX2
+#endif
+} // namespace ppx
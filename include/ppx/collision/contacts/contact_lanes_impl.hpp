@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ppx/collision/contacts/contact_lanes.hpp"
+
+// Only meant to be included by the translation units defining the SIMD kernels. The AVX2 one includes it inside a
+// target region, so nothing here may rely on inline functions shared with the rest of the library
+
+namespace ppx
+{
+// V is a SIMD float wrapper providing WIDTH, load, store, broadcast, min, max and the +, - and * operators
+template <typename V> inline void solve_contact_lanes(contact_lanes2D &l)
+{
+    static_assert(V::WIDTH <= contact_lanes2D::MAX_WIDTH, "SIMD width exceeds the lane capacity");
+    const V zero = V::broadcast(0.f);
+
+    V v1x = V::load(l.v1x);
+    V v1y = V::load(l.v1y);
+    V w1 = V::load(l.w1);
+    V v2x = V::load(l.v2x);
+    V v2y = V::load(l.v2y);
+    V w2 = V::load(l.w2);
+
+    const V nx = V::load(l.nx);
+    const V ny = V::load(l.ny);
+    const V r1x = V::load(l.r1x);
+    const V r1y = V::load(l.r1y);
+    const V r2x = V::load(l.r2x);
+    const V r2y = V::load(l.r2y);
+
+    const V im1 = V::load(l.imass1);
+    const V im2 = V::load(l.imass2);
+    const V ii1 = V::load(l.iinertia1);
+    const V ii2 = V::load(l.iinertia2);
+
+    V normal_impulse = V::load(l.normal_impulse);
+    V tangent_impulse = V::load(l.tangent_impulse);
+
+    // friction first, clamped by the current normal impulse
+    const V tx = zero - ny;
+    const V ty = nx;
+    V dvx = (v2x - w2 * r2y) - (v1x - w1 * r1y);
+    V dvy = (v2y + w2 * r2x) - (v1y + w1 * r1x);
+
+    const V max_friction = V::load(l.friction) * normal_impulse;
+    const V vt = dvx * tx + dvy * ty;
+    const V new_tangent =
+        V::min(V::max(tangent_impulse - vt * V::load(l.tangent_mass), zero - max_friction), max_friction);
+    const V dt = new_tangent - tangent_impulse;
+    tangent_impulse = new_tangent;
+
+    V px = dt * tx;
+    V py = dt * ty;
+    v1x = v1x - im1 * px;
+    v1y = v1y - im1 * py;
+    w1 = w1 - ii1 * (r1x * py - r1y * px);
+    v2x = v2x + im2 * px;
+    v2y = v2y + im2 * py;
+    w2 = w2 + ii2 * (r2x * py - r2y * px);
+
+    // then the non penetration row
+    dvx = (v2x - w2 * r2y) - (v1x - w1 * r1y);
+    dvy = (v2y + w2 * r2x) - (v1y + w1 * r1x);
+
+    const V vn = dvx * nx + dvy * ny + V::load(l.bias);
+    const V new_normal = V::max(normal_impulse - vn * V::load(l.normal_mass) * V::load(l.mass_scale) -
+                                    V::load(l.impulse_scale) * normal_impulse,
+                                zero);
+    const V dn = new_normal - normal_impulse;
+    normal_impulse = new_normal;
+
+    const V pnx = dn * nx;
+    const V pny = dn * ny;
+    v1x = v1x - im1 * pnx;
+    v1y = v1y - im1 * pny;
+    w1 = w1 - ii1 * (r1x * pny - r1y * pnx);
+    v2x = v2x + im2 * pnx;
+    v2y = v2y + im2 * pny;
+    w2 = w2 + ii2 * (r2x * pny - r2y * pnx);
+    px = px + pnx;
+    py = py + pny;
+
+    V::store(l.v1x, v1x);
+    V::store(l.v1y, v1y);
+    V::store(l.w1, w1);
+    V::store(l.v2x, v2x);
+    V::store(l.v2y, v2y);
+    V::store(l.w2, w2);
+    V::store(l.normal_impulse, normal_impulse);
+    V::store(l.tangent_impulse, tangent_impulse);
+    V::store(l.px, px);
+    V::store(l.py, py);
+}
+} // namespace ppx
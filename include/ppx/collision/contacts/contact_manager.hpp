@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ppx/collision/contacts/contact.hpp"
+#include "ppx/collision/contacts/contact_solver.hpp"
+#include "ppx/collision/contacts/contact_table.hpp"
+#include "ppx/collision/contacts/impulse_cache.hpp"
 #include "ppx/collision/contacts/icontact_manager.hpp"
 #include "ppx/manager.hpp"
+#include "kit/multithreading/mt_for_each.hpp"
 
 #ifdef _MSC_VER
 #pragma warning(push) // Inheritance via dominance is intended
@@ -14,18 +18,33 @@ namespace ppx
 template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>, virtual public icontact_manager2D
 {
   public:
-    using contact_map = std::unordered_map<contact_key, Contact *>;
+    using contact_map = contact_table2D<Contact>;
     using manager2D<Contact>::manager2D;
 
+    static inline constexpr bool CACHES_IMPULSES = requires(Contact *contact) {
+        contact->inherit_impulses(0.f, 0.f);
+    };
+    static inline constexpr bool CARRIES_APPROACH = requires(Contact *contact) {
+        contact->speculative();
+        contact->inherit_approach_velocity(contact->approach_velocity());
+    };
+
     virtual ~contact_manager2D()
     {
         destroy_all_contacts();
     }
 
+    // contacts of sleeping islands are parked apart, so that the per step bookkeeping only walks the awake ones.
+    // contacts(), iteration, size() and indexing only cover awake contacts. parked contacts are still alive and are
+    // reached through dormant_contacts(), or together with the awake ones through the total and active lists
     const std::vector<Contact *> &contacts() const
     {
         return this->m_elements;
     }
+    const std::vector<Contact *> &dormant_contacts() const
+    {
+        return m_dormant;
+    }
     const contact_map &contacts_map() const
     {
         return m_unique_contacts;
@@ -45,32 +64,38 @@ template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>
 
     std::vector<contact2D *> create_total_contacts_list() const override final
     {
-        return std::vector<contact2D *>(this->m_elements.begin(), this->m_elements.end());
+        std::vector<contact2D *> contacts(this->m_elements.begin(), this->m_elements.end());
+        contacts.insert(contacts.end(), m_dormant.begin(), m_dormant.end());
+        return contacts;
     }
     std::vector<contact2D *> create_active_contacts_list() const override final
     {
         std::vector<contact2D *> active_contacts;
-        active_contacts.reserve(this->m_elements.size());
+        active_contacts.reserve(this->m_elements.size() + m_dormant.size());
         for (Contact *contact : this->m_elements)
             if (contact->enabled()) [[likely]]
                 active_contacts.push_back(contact);
+        for (Contact *contact : m_dormant)
+            if (contact->enabled()) [[likely]]
+                active_contacts.push_back(contact);
         return active_contacts;
     }
 
     std::size_t total_contacts_count() const override final
     {
-        return this->m_elements.size();
+        return this->m_elements.size() + m_dormant.size();
     }
 
     void remove_any_contacts_with(const collider2D *collider) override final
     {
+        unpark_all_contacts();
         for (auto it = this->m_elements.begin(); it != this->m_elements.end();)
         {
             Contact *contact = *it;
             if (contact->collider1() == collider || contact->collider2() == collider)
             {
                 if (contact->enabled()) [[likely]]
-                    contact->on_exit();
+                    contact->on_exit(collider);
                 m_unique_contacts.erase(contact->key());
                 destroy_contact(contact);
                 it = this->m_elements.erase(it);
@@ -82,14 +107,18 @@ template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>
 
   protected:
     std::vector<Contact *> m_last_contacts;
+    std::vector<Contact *> m_dormant;
+    std::vector<contact_key> m_expired_keys;
     contact_map m_unique_contacts;
+    impulse_cache2D m_impulse_cache;
 
   private:
     void create_from_collision(const collision2D &collision) override final
     {
         for (std::size_t i = 0; i < collision.manifold.size(); i++)
         {
-            const contact_key hash{collision.collider1, collision.collider2, collision.manifold[i].id.key};
+            const contact_key hash = contact2D::make_key(collision.collider1, collision.collider2,
+                                                         collision.manifold[i].id.key);
             create_contact(hash, &collision, i);
         }
     }
@@ -97,46 +126,69 @@ template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>
     {
         for (std::size_t i = collision.manifold.size() - 1; i < collision.manifold.size(); i--)
         {
-            const contact_key hash{collision.collider1, collision.collider2, collision.manifold[i].id.key};
-            const auto old_contact = m_unique_contacts.find(hash);
-            if (old_contact != m_unique_contacts.end())
+            const contact_key hash = contact2D::make_key(collision.collider1, collision.collider2,
+                                                         collision.manifold[i].id.key);
+            if (Contact *old_contact = m_unique_contacts.find(hash))
             {
-                update_contact(old_contact->second, &collision, i);
+                update_contact(old_contact, &collision, i);
                 collision.manifold.erase(collision.manifold.begin() + i);
             }
         }
     }
     void create_or_update_from_collision(const collision2D &collision) override final
     {
+        // all updates go first so that new points never inherit impulses from contacts that are still alive
         for (std::size_t i = 0; i < collision.manifold.size(); i++)
         {
-            const contact_key hash{collision.collider1, collision.collider2, collision.manifold[i].id.key};
-            const auto old_contact = m_unique_contacts.find(hash);
-            if (old_contact != m_unique_contacts.end())
-                update_contact(old_contact->second, &collision, i);
-            else
+            const contact_key hash = contact2D::make_key(collision.collider1, collision.collider2,
+                                                         collision.manifold[i].id.key);
+            if (Contact *old_contact = m_unique_contacts.find(hash))
+                update_contact(old_contact, &collision, i);
+        }
+        for (std::size_t i = 0; i < collision.manifold.size(); i++)
+        {
+            const contact_key hash = contact2D::make_key(collision.collider1, collision.collider2,
+                                                         collision.manifold[i].id.key);
+            if (!m_unique_contacts.contains(hash))
                 create_contact(hash, &collision, i);
         }
     }
     void remove_expired_contacts() override final
     {
         KIT_PERF_SCOPE("ppx::contact_manager2D::remove_expired_contacts")
+        const bool park = this->world.islands.enabled() && this->world.islands.params.enable_sleep;
+        if (!park)
+            unpark_all_contacts();
+
         std::swap(m_last_contacts, this->m_elements);
         this->m_elements.clear();
+        m_expired_keys.clear();
         for (Contact *contact : m_last_contacts)
         {
             if (contact->asleep())
             {
-                this->m_elements.push_back(contact);
+                // a kinematic body may start moving without waking the island, so its contacts are kept around
+                if (park && !contact->body1()->is_kinematic() && !contact->body2()->is_kinematic())
+                    park_contact(contact);
+                else
+                    this->m_elements.push_back(contact);
                 continue;
             }
             if (contact->expired())
             {
-                m_unique_contacts.erase(contact->key());
+                m_expired_keys.push_back(contact->key());
+                if constexpr (CACHES_IMPULSES)
+                    if (this->params.persistent_impulses)
+                    {
+                        const impulse_cache2D::point pt{contact->lanchor1(), contact->normal_impulse(),
+                                                        contact->tangent_impulse()};
+                        m_impulse_cache.store(contact->key().colliders, pt, this->world.step_count(),
+                                              this->params.impulse_match_distance);
+                    }
                 destroy_contact(contact);
                 continue;
             }
-            if (!contact->recently_updated())
+            if (!contact->recently_updated() && contact->enabled())
             {
                 contact->enabled(false);
                 contact->on_exit();
@@ -144,20 +196,148 @@ template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>
             contact->increment_age();
             this->m_elements.push_back(contact);
         }
+
+        if constexpr (CACHES_IMPULSES)
+            if (this->world.step_count() % impulse_cache2D::LIFETIME == 0)
+                m_impulse_cache.purge(this->world.step_count());
+
+        // a handful of expirations are erased in place. past that, re-inserting the survivors is cheaper
+        if (4 * m_expired_keys.size() > total_contacts_count())
+            rebuild_unique_contacts();
+        else
+            for (const contact_key &key : m_expired_keys)
+                m_unique_contacts.erase(key);
+    }
+
+    void apply_pre_solve_filter(const std::function<bool(contact2D *)> &filter) override final
+    {
+        for (Contact *contact : this->m_elements)
+            if (contact->enabled() && !filter(contact))
+            {
+                contact->enabled(false);
+                contact->on_exit();
+            }
+    }
+    void record_active_contacts() override final
+    {
+        for (Contact *contact : this->m_elements)
+            if (contact->enabled()) [[likely]]
+                this->record(contact);
+    }
+
+    void park_contact(Contact *contact)
+    {
+        contact->meta.dormant_slot = m_dormant.size();
+        m_dormant.push_back(contact);
+    }
+    // called when an island wakes up, so it costs as much as the island has contacts
+    void unpark_contacts(const std::vector<contact2D *> &contacts) override final
+    {
+        for (contact2D *contact : contacts)
+        {
+            const std::size_t slot = contact->meta.dormant_slot;
+            if (slot == SIZE_MAX)
+                continue;
+            Contact *last = m_dormant.back();
+            m_dormant[slot] = last;
+            last->meta.dormant_slot = slot;
+            m_dormant.pop_back();
+
+            contact->meta.dormant_slot = SIZE_MAX;
+            this->m_elements.push_back(static_cast<Contact *>(contact));
+        }
+    }
+    void unpark_all_contacts()
+    {
+        for (Contact *contact : m_dormant)
+        {
+            contact->meta.dormant_slot = SIZE_MAX;
+            this->m_elements.push_back(contact);
+        }
+        m_dormant.clear();
+    }
+
+    void rebuild_unique_contacts()
+    {
+        if (m_dormant.empty())
+        {
+            m_unique_contacts.rebuild(this->m_elements);
+            return;
+        }
+        m_last_contacts.assign(this->m_elements.begin(), this->m_elements.end());
+        m_last_contacts.insert(m_last_contacts.end(), m_dormant.begin(), m_dormant.end());
+        m_unique_contacts.rebuild(m_last_contacts);
     }
 
     void create_contact(const contact_key &hash, const collision2D *collision, const std::size_t manifold_index)
     {
         Contact *contact = allocator<Contact>::create(this->world, collision, manifold_index);
         KIT_ASSERT_ERROR(!m_unique_contacts.contains(hash), "Contact already exists!")
+        if constexpr (IConstraint2D<Contact>)
+            constraint_kind2D::assign(contact);
 
-        m_unique_contacts.emplace(hash, contact);
+        m_unique_contacts.insert(hash, contact);
         this->m_elements.push_back(contact);
+        if constexpr (CACHES_IMPULSES)
+            if (this->params.persistent_impulses)
+                warmstart_from_previous(contact);
+        if constexpr (CARRIES_APPROACH)
+            carry_approach_velocity(contact);
         island2D::add(contact);
-        contact->body1()->meta.contacts.push_back(contact);
-        contact->body2()->meta.contacts.push_back(contact);
+        contact->body1()->meta.add_contact(contact);
+        contact->body2()->meta.add_contact(contact);
         contact->on_enter();
     }
+    // a point whose feature id changed leaves its old contact alive but not updated this step. those are preferred over
+    // the cache, which only holds points of contacts that already expired
+    void warmstart_from_previous(Contact *contact)
+    {
+        const float max_dist = this->params.impulse_match_distance;
+        const Contact *closest = nullptr;
+        float min_dist = max_dist * max_dist;
+        for (const contact2D *other : contact->body1()->meta.contacts)
+        {
+            if (other == contact || other->collider1() != contact->collider1() ||
+                other->collider2() != contact->collider2() || other->recently_updated())
+                continue;
+            const glm::vec2 diff = other->lanchor1() - contact->lanchor1();
+            const float dist = glm::dot(diff, diff);
+            if (dist <= min_dist)
+            {
+                min_dist = dist;
+                closest = static_cast<const Contact *>(other);
+            }
+        }
+        if (closest)
+        {
+            contact->inherit_impulses(closest->normal_impulse(), closest->tangent_impulse());
+            return;
+        }
+
+        impulse_cache2D::point pt;
+        if (m_impulse_cache.take(contact->key().colliders, contact->lanchor1(), this->world.step_count(), max_dist, pt))
+            contact->inherit_impulses(pt.normal_impulse, pt.tangent_impulse);
+    }
+
+    // a pair is either touching or holds a single speculative point, so a speculative contact of the same pair that was
+    // alive last step is the one that braked the approach of this one
+    void carry_approach_velocity(Contact *contact)
+    {
+        if (contact->speculative())
+            return;
+        for (const contact2D *other : contact->body1()->meta.contacts)
+            if (other != contact && other->collider1() == contact->collider1() &&
+                other->collider2() == contact->collider2() && other->age() == 1)
+            {
+                const Contact *previous = static_cast<const Contact *>(other);
+                if (previous->speculative())
+                {
+                    contact->inherit_approach_velocity(previous->approach_velocity());
+                    return;
+                }
+            }
+    }
+
     void update_contact(Contact *contact, const collision2D *collision, const std::size_t manifold_index)
     {
         KIT_ASSERT_WARN(!contact->recently_updated(),
@@ -180,16 +360,16 @@ template <Contact2D Contact> class contact_manager2D : public manager2D<Contact>
 
     void destroy_all_contacts() override final
     {
+        unpark_all_contacts();
         for (Contact *contact : this->m_elements)
         {
             if (contact->enabled()) [[likely]]
                 contact->on_exit();
             destroy_contact(contact);
-        } // this is expensive, for every contact a call to remove_contact for
-          // colliders and bodies. it shouldnt matter because this is almost never
-          // called (only when user changes contact solver or disables collisions)
+        }
         this->m_elements.clear();
         m_unique_contacts.clear();
+        m_impulse_cache.clear();
     }
 };
 
@@ -197,29 +377,54 @@ template <ContactConstraint2D Contact>
 class contact_constraint_manager2D final : public contact_manager2D<Contact>, public icontact_constraint_manager2D
 {
   public:
+    // contacts the packed contact solver knows how to handle skip the per contact virtual dispatch when iterating
+    static inline constexpr bool PACKED = std::is_same_v<Contact, nonpen_contact2D>;
+
     virtual ~contact_constraint_manager2D() = default;
     using contact_manager2D<Contact>::contact_manager2D;
 
     void startup(std::vector<state2D> &states) override
     {
         m_active_contacts.clear();
+        if constexpr (PACKED)
+            m_solver.startup(states);
         for (Contact *contact : this->m_elements)
         {
             if (!contact->enabled()) [[likely]]
                 continue;
-            contact->on_pre_solve();
-            if (contact->enabled()) [[likely]] // could be disabled by on_pre_solve
-            {
-                m_active_contacts.push_back(contact);
-                contact->startup(states);
-            }
+            m_active_contacts.push_back(contact);
+            contact->startup(states);
+            if constexpr (PACKED)
+                m_solver.add(contact);
         }
     }
 
     void solve_velocities() override
     {
-        for (Contact *contact : m_active_contacts)
-            contact->solve_velocities();
+        if constexpr (PACKED)
+            m_solver.solve_velocities();
+        else
+            for (Contact *contact : m_active_contacts)
+                contact->solve_velocities();
+    }
+
+    void relax_velocities() override
+    {
+        if constexpr (PACKED)
+        {
+            m_solver.use_bias(false);
+            m_solver.solve_velocities();
+            m_solver.use_bias(true);
+        }
+        else
+            for (Contact *contact : m_active_contacts)
+                contact->solve_velocities();
+    }
+
+    void store_impulses() override
+    {
+        if constexpr (PACKED)
+            m_solver.store_impulses();
     }
 
     bool solve_positions() override
@@ -230,35 +435,111 @@ class contact_constraint_manager2D final : public contact_manager2D<Contact>, pu
         return solved;
     }
 
-    void on_post_solve() override
-    {
-        for (Contact *contact : m_active_contacts)
-            contact->on_post_solve();
-    }
-
   private:
     std::vector<Contact *> m_active_contacts;
+    contact_solver2D m_solver;
 };
 
 template <ContactActuator2D Contact>
 class contact_actuator_manager2D final : public contact_manager2D<Contact>, public icontact_actuator_manager2D
 {
   public:
+    // below this many contacts the bookkeeping of the parallel path costs more than it saves
+    static inline constexpr std::size_t PARALLEL_THRESHOLD = 512;
+
     virtual ~contact_actuator_manager2D() = default;
     using contact_manager2D<Contact>::contact_manager2D;
     void solve(std::vector<state2D> &states) override
     {
+        const auto pool = this->world.thread_pool;
+        if (this->params.multithreading && pool && this->m_elements.size() >= PARALLEL_THRESHOLD)
+        {
+            solve_mt(states);
+            return;
+        }
         for (Contact *contact : this->m_elements)
+            if (contact->enabled()) [[likely]]
+                contact->solve(states);
+    }
+
+  private:
+    std::vector<actuator2D::wrench> m_wrenches;
+    std::vector<std::size_t> m_contact_indices;
+
+    // per body lists of (contact index, endpoint) in contact order, laid out contiguously
+    std::vector<std::size_t> m_body_offsets;
+    std::vector<std::size_t> m_body_entries;
+    std::vector<std::size_t> m_touched_bodies;
+
+    // forces are computed in parallel into a per contact buffer, and then each body sums its own contributions in
+    // contact order. no two tasks write to the same state, and the result does not depend on the thread count
+    void solve_mt(std::vector<state2D> &states)
+    {
+        KIT_PERF_SCOPE("ppx::contact_actuator_manager2D::solve_mt")
+        const auto pool = this->world.thread_pool;
+        const std::size_t count = this->m_elements.size();
+
+        m_wrenches.resize(count);
+        if (m_contact_indices.size() != count)
         {
-            if (!contact->enabled()) [[likely]]
-                continue;
+            m_contact_indices.resize(count);
+            std::iota(m_contact_indices.begin(), m_contact_indices.end(), 0);
+        }
+
+        const auto compute = [this, &states](const std::size_t index) {
+            Contact *contact = this->m_elements[index];
+            m_wrenches[index] = contact->enabled() ? contact->compute_wrench(states) : actuator2D::wrench{};
+        };
+        kit::mt::for_each(*pool, m_contact_indices.begin(), m_contact_indices.end(), compute, pool->thread_count());
 
-            // on islands, all pre solves are executed before the firs solve ever, but here the implementation differs.
-            // take into account for the future :)
-            contact->on_pre_solve();
-            contact->solve(states);
-            contact->on_post_solve();
+        m_body_offsets.assign(states.size() + 1, 0);
+        for (const Contact *contact : this->m_elements)
+        {
+            m_body_offsets[contact->body1()->meta.index + 1]++;
+            m_body_offsets[contact->body2()->meta.index + 1]++;
+        }
+        m_touched_bodies.clear();
+        for (std::size_t i = 0; i < states.size(); i++)
+        {
+            if (m_body_offsets[i + 1] != 0)
+                m_touched_bodies.push_back(i);
+            m_body_offsets[i + 1] += m_body_offsets[i];
         }
+
+        m_body_entries.resize(2 * count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const Contact *contact = this->m_elements[i];
+            m_body_entries[m_body_offsets[contact->body1()->meta.index]++] = 2 * i;
+            m_body_entries[m_body_offsets[contact->body2()->meta.index]++] = 2 * i + 1;
+        }
+        // the fill above shifted every offset to the start of the next body
+        for (std::size_t i = states.size(); i > 0; i--)
+            m_body_offsets[i] = m_body_offsets[i - 1];
+        m_body_offsets[0] = 0;
+
+        const auto reduce = [this, &states](const std::size_t body) {
+            glm::vec2 force{0.f};
+            float torque = 0.f;
+            for (std::size_t j = m_body_offsets[body]; j < m_body_offsets[body + 1]; j++)
+            {
+                const std::size_t entry = m_body_entries[j];
+                const actuator2D::wrench &w = m_wrenches[entry / 2];
+                if (entry % 2 == 0)
+                {
+                    force -= w.force;
+                    torque -= w.torque1;
+                }
+                else
+                {
+                    force += w.force;
+                    torque += w.torque2;
+                }
+            }
+            states[body].substep_force += force;
+            states[body].substep_torque += torque;
+        };
+        kit::mt::for_each(*pool, m_touched_bodies.begin(), m_touched_bodies.end(), reduce, pool->thread_count());
     }
 };
 } // namespace ppx
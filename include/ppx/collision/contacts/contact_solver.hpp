@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ppx/collision/contacts/nonpen_contact.hpp"
+#include "ppx/collision/contacts/contact_lanes.hpp"
+#include <unordered_map>
+
+namespace ppx
+{
+// Solves the velocities of nonpen_contact2D over flat, tightly packed rows (structure of arrays) instead of chasing
+// contact pointers through virtual calls every iteration. Contacts are still started up individually (anchors,
+// masses, warmup) and then gathered once per stage. Accumulated impulses are scattered back with store_impulses()
+// Rows belonging to the same two-point manifold are paired and their normal impulses are solved together
+// as a 2x2 LCP, which converges in far fewer iterations for resting stacks. Ill-conditioned pairs and pairs for which
+// no LCP case applies fall back to the sequential per-row solve
+// A solve unit is either a single row or a paired block. Units touching disjoint dynamic bodies may be solved
+// concurrently, which is what the unit accessors are for. A batch of such independent units can be handed to
+// solve_units(), which solves its single rows several at a time with the widest SIMD kernel the CPU supports
+// In soft step mode rows are soft constraints whose position bias is only applied while use_bias is on, so that the
+// relax pass that follows each substep can remove the velocity the bias introduced. Rows are never paired in that mode
+class contact_solver2D
+{
+  public:
+    void startup(std::vector<state2D> &states);
+    void add(nonpen_contact2D *contact);
+
+    // every solve returns the largest impulse change it applied, which callers may use as a convergence residual
+    float solve_velocities();
+    float solve_unit(std::size_t unit);
+    float solve_units(const std::size_t *units, std::size_t count); // units must not share a dynamic body
+    void use_bias(bool use_bias);
+    void store_impulses() const;
+    float largest_impulse() const; // largest accumulated normal or friction impulse of any row
+
+    const std::vector<nonpen_contact2D *> &contacts() const;
+    std::size_t size() const;
+    bool empty() const;
+
+    std::size_t unit_count() const;
+    std::size_t unit_index1(std::size_t unit) const;
+    std::size_t unit_index2(std::size_t unit) const;
+    bool unit_dynamic1(std::size_t unit) const;
+    bool unit_dynamic2(std::size_t unit) const;
+
+  private:
+    enum row_flags : std::uint8_t
+    {
+        DYNAMIC1 = 1 << 0,
+        DYNAMIC2 = 1 << 1,
+        FRICTION = 1 << 2
+    };
+
+    static inline constexpr float MAX_BLOCK_CONDITION = 1000.f;
+    static inline constexpr std::size_t NO_BLOCK = SIZE_MAX;
+
+    // a paired unit starts at its first row. the second one is kept by the block, as it need not be adjacent
+    struct row_unit
+    {
+        std::size_t row;
+        std::size_t block;
+    };
+
+    std::vector<state2D> *m_states = nullptr;
+    std::vector<nonpen_contact2D *> m_contacts;
+
+    std::vector<std::size_t> m_index1;
+    std::vector<std::size_t> m_index2;
+    std::vector<std::uint8_t> m_flags;
+
+    std::vector<float> m_imass1;
+    std::vector<float> m_imass2;
+    std::vector<float> m_iinertia1;
+    std::vector<float> m_iinertia2;
+
+    std::vector<glm::vec2> m_normal;
+    std::vector<glm::vec2> m_offset1;
+    std::vector<glm::vec2> m_offset2;
+
+    std::vector<float> m_normal_mass;
+    std::vector<float> m_tangent_mass;
+    std::vector<float> m_bias;
+    std::vector<float> m_relax_bias;
+    std::vector<float> m_mass_scale;
+    std::vector<float> m_impulse_scale;
+    std::vector<float> m_friction;
+
+    std::vector<float> m_normal_impulse;
+    std::vector<float> m_tangent_impulse;
+
+    std::vector<glm::mat2> m_block_k;
+    std::vector<glm::mat2> m_block_mass;
+    std::vector<std::size_t> m_block_row2;
+    std::vector<row_unit> m_units;
+
+    // unit of the last unpaired row of every collider pair gathered so far
+    std::unordered_map<std::uint64_t, std::size_t> m_open_pairs;
+
+    float m_inv_ts = 0.f;
+    bool m_soft = false;
+    bool m_use_bias = true;
+
+    void apply_impulse(std::size_t row, const glm::vec2 &impulse, state2D &state1, state2D &state2) const;
+
+    float solve_friction(std::size_t row, state2D &state1, state2D &state2);
+    float solve_normal(std::size_t row, state2D &state1, state2D &state2);
+    float solve_block(std::size_t row, std::size_t block, state2D &state1, state2D &state2);
+
+    void gather_lane(contact_lanes2D &lanes, std::size_t lane, std::size_t row) const;
+    float scatter_lane(const contact_lanes2D &lanes, std::size_t lane, std::size_t row);
+    float solve_lanes(const contact_lanes_kernel2D &kernel, const std::size_t *rows);
+
+    void add_soft_row(const nonpen_contact2D *contact, float max_push);
+    bool try_pair(std::size_t row2);
+};
+} // namespace ppx
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "ppx/collision/contacts/contact.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace ppx
+{
+// Flat open addressing (linear probing) table mapping contact keys to contacts. Slots hold the key by value, so a probe
+// touches a single contiguous array and no nodes are ever allocated. Erasing shifts the following cluster back instead
+// of leaving tombstones, so probe sequences never degrade with churn. The table stays at most half full
+template <typename Contact> class contact_table2D
+{
+  public:
+    using contact_key = contact2D::contact_key;
+
+    Contact *find(const contact_key &key) const
+    {
+        if (m_size == 0)
+            return nullptr;
+        for (std::size_t i = slot_index(key);; i = (i + 1) & m_mask)
+        {
+            const slot &s = m_slots[i];
+            if (!s.contact)
+                return nullptr;
+            if (s.key == key)
+                return s.contact;
+        }
+    }
+    bool contains(const contact_key &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    void insert(const contact_key &key, Contact *contact)
+    {
+        KIT_ASSERT_ERROR(contact, "Cannot insert a null contact")
+        if (2 * (m_size + 1) > m_slots.size())
+            grow(2 * (m_size + 1));
+
+        std::size_t i = slot_index(key);
+        while (m_slots[i].contact)
+        {
+            KIT_ASSERT_ERROR(!(m_slots[i].key == key), "Contact key already present in the table")
+            i = (i + 1) & m_mask;
+        }
+        m_slots[i] = {key, contact};
+        m_size++;
+    }
+
+    bool erase(const contact_key &key)
+    {
+        if (m_size == 0)
+            return false;
+        std::size_t hole = slot_index(key);
+        for (;; hole = (hole + 1) & m_mask)
+        {
+            if (!m_slots[hole].contact)
+                return false;
+            if (m_slots[hole].key == key)
+                break;
+        }
+
+        // backward shift: pull back every entry of the cluster whose home slot is not between the hole and itself
+        for (std::size_t i = (hole + 1) & m_mask; m_slots[i].contact; i = (i + 1) & m_mask)
+        {
+            const std::size_t home = slot_index(m_slots[i].key);
+            if (((i - home) & m_mask) >= ((i - hole) & m_mask))
+            {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+        m_slots[hole] = {};
+        m_size--;
+        return true;
+    }
+
+    // re-inserts every contact from scratch. cheaper than many scattered erases, and required when collider indices
+    // shift because the keys themselves change
+    void rebuild(const std::vector<Contact *> &contacts)
+    {
+        clear();
+        if (contacts.empty())
+            return;
+        if (2 * contacts.size() > m_slots.size())
+            grow(2 * contacts.size());
+        for (Contact *contact : contacts)
+            insert(contact->key(), contact);
+    }
+
+    void clear()
+    {
+        std::fill(m_slots.begin(), m_slots.end(), slot{});
+        m_size = 0;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+  private:
+    struct slot
+    {
+        contact_key key{};
+        Contact *contact = nullptr;
+    };
+
+    std::vector<slot> m_slots;
+    std::size_t m_mask = 0;
+    std::size_t m_size = 0;
+
+    std::size_t slot_index(const contact_key &key) const
+    {
+        // splitmix64 finalizer. collider indices are small and sequential, so the raw key hashes terribly on its own
+        std::uint64_t h = key.colliders ^ (static_cast<std::uint64_t>(key.feature) * 0x9e3779b97f4a7c15ULL);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return static_cast<std::size_t>(h) & m_mask;
+    }
+
+    void grow(const std::size_t min_capacity)
+    {
+        std::size_t capacity = m_slots.empty() ? 16 : m_slots.size();
+        while (capacity < min_capacity)
+            capacity *= 2;
+        if (capacity == m_slots.size())
+            return;
+
+        std::vector<slot> old = std::move(m_slots);
+        m_slots.assign(capacity, slot{});
+        m_mask = capacity - 1;
+        m_size = 0;
+        for (const slot &s : old)
+            if (s.contact)
+            {
+                std::size_t i = slot_index(s.key);
+                while (m_slots[i].contact)
+                    i = (i + 1) & m_mask;
+                m_slots[i] = s;
+                m_size++;
+            }
+    }
+};
+} // namespace ppx
@@ -4,10 +4,12 @@
 #include "ppx/collision/broad/broad_phase.hpp"
 #include "ppx/internal/worldref.hpp"
 #include "ppx/collision/contacts/contact.hpp"
+#include "ppx/collision/contacts/contact_event.hpp"
 #include "ppx/island/island.hpp"
 #include "kit/interface/toggleable.hpp"
 #include "kit/container/hashable_tuple.hpp"
 #include "kit/utility/type_constraints.hpp"
+#include <functional>
 
 namespace ppx
 {
@@ -38,19 +40,32 @@ class icontact_manager2D : virtual public kit::toggleable
 
     specs::collision_manager2D::contacts2D params;
 
+  protected:
+    void record(contact2D *contact);
+
   private:
+    std::vector<contact_event2D> m_events;
+
     virtual void destroy_all_contacts() = 0;
     virtual void remove_expired_contacts() = 0;
+    virtual void apply_pre_solve_filter(const std::function<bool(contact2D *)> &filter) = 0;
+    virtual void record_active_contacts() = 0;
+    virtual void unpark_contacts(const std::vector<contact2D *> &contacts) = 0;
+
+    void record_end(const contact2D &contact, const collider2D *removed);
 
     friend class collision_manager2D;
+    friend class contact2D;
+    friend class island2D;
 };
 class icontact_constraint_manager2D : virtual public icontact_manager2D
 {
   public:
     virtual void startup(std::vector<state2D> &states) = 0;
     virtual void solve_velocities() = 0;
+    virtual void relax_velocities() = 0;
+    virtual void store_impulses() = 0;
     virtual bool solve_positions() = 0;
-    virtual void on_post_solve() = 0;
 };
 
 class icontact_actuator_manager2D : virtual public icontact_manager2D
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ppx/common/alias.hpp"
+#include <unordered_map>
+#include <array>
+#include <cstdint>
+
+namespace ppx
+{
+// Remembers the accumulated impulses of contacts that went away, keyed by collider id pair. A contact created for the
+// same pair shortly after can pick up the impulse of the nearest old point (in the first body's local space) and warm
+// start from it instead of from zero. Entries are forgotten after a few steps
+class impulse_cache2D
+{
+  public:
+    struct point
+    {
+        glm::vec2 lanchor1;
+        float normal_impulse;
+        float tangent_impulse;
+    };
+
+    static inline constexpr std::uint32_t LIFETIME = 8; // in steps
+
+    void store(std::uint64_t pair, const point &pt, std::uint32_t step, float match_distance);
+    bool take(std::uint64_t pair, const glm::vec2 &lanchor1, std::uint32_t step, float match_distance, point &pt);
+
+    void purge(std::uint32_t step);
+    void clear();
+
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    struct entry
+    {
+        std::array<point, 2> points;
+        std::uint32_t count = 0;
+        std::uint32_t step = 0;
+    };
+
+    std::unordered_map<std::uint64_t, entry> m_entries;
+};
+} // namespace ppx
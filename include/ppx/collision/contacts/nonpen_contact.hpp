@@ -22,6 +22,19 @@ class nonpen_contact2D final : public contact2D, public pvconstraint2D<1, 0>
     void solve_velocities() override;
     void update(const collision2D *collision, std::size_t manifold_index) override;
 
+    bool speculative() const;
+
+    float normal_impulse() const override;
+    float tangent_impulse() const override;
+
+    // seeds the accumulated impulses of a fresh contact so that it warm starts where an old one left off
+    void inherit_impulses(float normal_impulse, float tangent_impulse);
+
+    // speculative points brake the approach before the bodies touch, so the contact that replaces one measures an
+    // already slowed down velocity. it bounces off the approach velocity the speculative point saw instead
+    float approach_velocity() const;
+    void inherit_approach_velocity(float velocity);
+
     static inline specs::constraint2D::properties global_props{};
 
   private:
@@ -30,12 +43,19 @@ class nonpen_contact2D final : public contact2D, public pvconstraint2D<1, 0>
 
     bool m_has_friction;
     bool m_is_adjusting_positions = false;
+    bool m_speculative;
 
     float m_init_ctr_vel = 0.f;
+    float m_approach_vel = 0.f;
+
+    float normal_velocity(const glm::vec2 &point) const;
+    void restitution_velocity(float velocity);
 
     void update_position_data() override;
     void warmup() override;
     glm::vec2 direction() const override;
+
+    friend class contact_solver2D;
 };
 } // namespace ppx
 
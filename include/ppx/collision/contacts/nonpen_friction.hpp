@@ -25,5 +25,8 @@ class nonpen_friction2D final : public vconstraint2D<1, 0>
     glm::vec2 m_tangent;
 
     glm::vec2 direction() const override;
+
+    friend class nonpen_contact2D;
+    friend class contact_solver2D;
 };
 } // namespace ppx
\ No newline at end of file
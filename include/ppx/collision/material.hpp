@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace ppx
+{
+struct material2D
+{
+    enum class combine_mode : std::uint8_t
+    {
+        GEOMETRIC_MEAN = 0,
+        AVERAGE = 1,
+        MIN = 2,
+        MULTIPLY = 3,
+        MAX = 4
+    };
+
+    float friction = 0.8f;
+    float restitution = 0.f;
+
+    // when two materials disagree, the mode with the highest value wins
+    combine_mode friction_combine = combine_mode::GEOMETRIC_MEAN;
+    combine_mode restitution_combine = combine_mode::GEOMETRIC_MEAN;
+};
+
+// Friction and restitution of a single collider, together with their square roots. The roots are resolved when the
+// values are assigned, so that geometric means never need a square root per pair
+struct surface2D
+{
+    float friction;
+    float restitution;
+    float friction_root;
+    float restitution_root;
+
+    static surface2D resolve(float friction, float restitution);
+};
+
+// Dense table holding the combined friction and restitution of every material pair, so that the narrow phase only
+// does a lookup per collision. Material 0 is reserved: colliders using it bring their own friction and restitution,
+// which combine with a geometric mean against each other, or with the combine modes of the other collider's material
+// when it has one. Pairs can be overridden explicitly
+class material_table2D
+{
+  public:
+    using material_id = std::uint32_t;
+
+    struct pair_properties
+    {
+        float friction;
+        float restitution;
+    };
+    struct pair_override
+    {
+        material_id id1;
+        material_id id2;
+        pair_properties props;
+    };
+
+    material_table2D();
+
+    material_id add(const material2D &material);
+    void set(material_id id, const material2D &material);
+    void override_pair(material_id id1, material_id id2, const pair_properties &props);
+
+    const material2D &operator[](material_id id) const;
+
+    // ids out of range fall back to material 0, as collider ids are not checked against the table when set
+    const pair_properties &combine(material_id id1, material_id id2) const;
+    pair_properties combine(material_id id, const surface2D &surface) const; // a material 0 collider on one side
+    pair_properties combine(const surface2D &surface1, const surface2D &surface2) const; // material 0 on both
+    bool contains(material_id id) const;
+
+    std::size_t size() const;
+    void clear();
+
+    const std::vector<pair_override> &overrides() const;
+
+  private:
+    std::vector<material2D> m_materials;
+    std::vector<surface2D> m_surfaces;
+    std::vector<pair_override> m_overrides;
+    std::vector<pair_properties> m_pairs;
+
+    void rebuild();
+};
+} // namespace ppx
@@ -11,6 +11,8 @@ class gjk_epa_narrow2D final : public narrow_phase2D
 
     const char *name() const override;
 
+    using narrow_phase2D::polygon_polygon;
+
     result circle_polygon(const circle &circ, const polygon &poly) const override;
     result polygon_polygon(const polygon &poly1, const polygon &poly2) const override;
 
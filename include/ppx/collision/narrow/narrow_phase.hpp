@@ -28,6 +28,9 @@ class narrow_phase2D : public worldref2D, public kit::toggleable, kit::non_copya
     virtual result polygon_polygon(const polygon &poly1, const polygon &poly2) const = 0;
     virtual result circle_polygon(const circle &circ, const polygon &poly) const = 0;
 
+    // colliders carry cached local data (normals, radius) some algorithms can take advantage of
+    virtual result polygon_polygon(const collider2D &collider1, const collider2D &collider2) const;
+
     void update_contacts(const std::vector<pair> &pairs, icontact_manager2D *contacts);
     virtual const char *name() const;
 
@@ -46,8 +49,10 @@ class narrow_phase2D : public worldref2D, public kit::toggleable, kit::non_copya
     void cc_narrow_collision_check(collider2D *collider1, collider2D *collider2, collision2D &collision) const;
     void cp_narrow_collision_check(collider2D *collider1, collider2D *collider2, collision2D &collision) const;
     void pp_narrow_collision_check(collider2D *collider1, collider2D *collider2, collision2D &collision) const;
+    void speculative_collision_check(collider2D *collider1, collider2D *collider2, collision2D &collision) const;
 
     icontact_manager2D *m_contacts = nullptr;
+    bool m_speculative = false;
 };
 
 } // namespace ppx
\ No newline at end of file
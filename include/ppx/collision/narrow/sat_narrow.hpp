@@ -11,7 +11,10 @@ class sat_narrow2D final : public narrow_phase2D
 
     const char *name() const override;
 
+    using narrow_phase2D::polygon_polygon;
+
     result circle_polygon(const circle &circ, const polygon &poly) const override;
     result polygon_polygon(const polygon &poly1, const polygon &poly2) const override;
+    result polygon_polygon(const collider2D &collider1, const collider2D &collider2) const override;
 };
 } // namespace ppx
\ No newline at end of file
@@ -42,6 +42,7 @@ struct collider2D
         float radius = 2.5f;
         stype shape = stype::POLYGON;
         filter collision_filter{};
+        std::uint32_t material = 0;
     } props;
     static collider2D from_instance(const ppx::collider2D &collider);
 };
@@ -64,6 +65,13 @@ struct body2D
         float charge = 1.f;
         std::vector<collider2D> colliders{};
         btype type = btype::DYNAMIC;
+
+        // if positive, the body counts as still for sleeping purposes whenever its linear speed is below it and its
+        // angular speed is below sleep_angular_velocity_threshold, and its kinetic energy is left out of the island
+        // average. without an angular threshold, the speed of rotation at the radius of gyration is held against the
+        // linear threshold instead
+        float sleep_velocity_threshold = 0.f;
+        float sleep_angular_velocity_threshold = 0.f;
     } props;
     static body2D from_instance(const ppx::body2D &body);
 };
@@ -79,6 +87,10 @@ struct joint2D
     struct properties
     {
         bool bodies_collide = true;
+
+        // projected by the xpbd solver instead of being solved as usual. only spring, distance and ball joints
+        // support it
+        bool position_based = false;
     };
 };
 
@@ -192,6 +204,15 @@ struct body_manager2D
     bool multithreading = true;
 };
 
+struct interaction2D
+{
+    // approximates groups of far away bodies with a quadtree instead of summing every pair (Barnes-Hut)
+    bool barnes_hut = false;
+    float opening_angle = 0.5f; // cell size over distance below which a cell is approximated. 0 is exact
+    std::uint32_t leaf_capacity = 8;
+    bool multithreading = false; // force_pair must then be thread safe
+};
+
 struct collider_manager2D
 {
     float bbox_enlargement = 0.1f;
@@ -213,7 +234,34 @@ struct joint_manager2D
 
         float max_position_correction = 0.2f;
         float position_resolution_speed = 0.2f;
+
+        // reuse the anchors, directions and effective masses computed in the first stage of a step for the rest of
+        // its stages (or substeps). faster with high order integrators, at the cost of some accuracy
+        bool freeze_jacobians = false;
+
+        // solve the hard equality joints of each (non colored) island with a sparse direct solver instead of iterating
+        // them. joint only islands then need a single velocity sweep
+        bool direct_joint_solver = false;
+
+        // soft step: a single collision pass followed by substeps that integrate velocities, solve once with soft
+        // contacts, integrate positions and relax once without position bias. replaces the rk stages and the
+        // velocity and position iterations. the rk integrator is bypassed, so its clock does not advance
+        bool soft_step = false;
+        std::uint32_t substeps = 4;
+        float max_contact_push_velocity = 3.f;
+
+        // islands stop sweeping velocities once the largest impulse change of a sweep falls below velocity_tolerance
+        // times the largest impulse accumulated in the island, and never sweep more than 1 + log2(bodies) times
+        bool adaptive_iterations = false;
+        float velocity_tolerance = 1.e-3f;
     } constraints;
+
+    // extended position based dynamics, used by the joints flagged as position based
+    struct xpbd2D
+    {
+        std::uint32_t iterations = 4;
+        bool multithreading = true;
+    } xpbd;
 };
 
 struct island_manager2D
@@ -221,8 +269,13 @@ struct island_manager2D
     float lower_sleep_energy_threshold = 0.001f;
     float upper_sleep_energy_threshold = 0.1f;
     std::uint32_t body_count_mid_threshold_reference = 100;
-    std::uint32_t steps_to_split = 120;
+    std::uint32_t steps_to_split = 120; // deprecated and ignored: islands are split as soon as they come apart
     float sleep_time_threshold = 1.5f;
+    std::uint32_t coloring_body_threshold = 512; // islands this large solve their constraints in parallel
+
+    // every this many steps, if islands changed, bodies are reordered so that each island is contiguous in the state
+    // array. this changes body indices, so it is disabled (0) by default
+    std::uint32_t reorder_interval = 0;
     bool enable_sleep = true;
     bool multithreading = true;
 };
@@ -236,11 +289,16 @@ struct collision_manager2D
     struct narrow2D
     {
         bool multithreading = true;
+        bool speculative_contacts = false;
+        float speculative_margin = 0.05f;
     } narrow;
 
     struct contacts2D
     {
         std::uint32_t contact_lifetime = 2; // in steps
+        bool persistent_impulses = true;
+        bool multithreading = true;
+        float impulse_match_distance = 0.1f; // in body1 local space
     } contacts;
 };
 
@@ -8,6 +8,40 @@ class constraint2D;
 template <typename T>
 concept IConstraint2D = kit::DerivedFrom<T, constraint2D>;
 
+// Statically dispatched velocity solve shared by every constraint of the same concrete type. Islands use it to solve
+// their constraints in per type batches instead of making a virtual call per constraint and iteration. Constraints
+// created outside a manager have no kind and are still solved through the virtual interface
+struct constraint_kind2D
+{
+    // returns the largest impulse change of the batch
+    float (*solve_velocities)(constraint2D *const *constraints, std::size_t count);
+
+    template <IConstraint2D T> static const constraint_kind2D *of()
+    {
+        static const constraint_kind2D kind{[](constraint2D *const *constraints, const std::size_t count) {
+            float delta = 0.f;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                static_cast<T *>(constraints[i])->T::solve_velocities();
+                delta = std::max(delta, constraints[i]->m_impulse_delta);
+            }
+            return delta;
+        }};
+        return &kind;
+    }
+    template <IConstraint2D T> static void assign(T *constraint)
+    {
+        constraint->m_kind = of<T>();
+    }
+};
+
+// A row of a constraint jacobian. The constraint velocity along the row is dot(body1, {v1, w1}) + dot(body2, {v2, w2})
+struct jacobian_row2D
+{
+    glm::vec3 body1;
+    glm::vec3 body2;
+};
+
 class constraint2D : virtual public joint2D
 {
   public:
@@ -18,7 +52,17 @@ class constraint2D : virtual public joint2D
 
     virtual bool solve_positions();
 
+    // hard equality constraints may be solved exactly by a direct_solver2D instead of iterated. such constraints report
+    // how many rows they have, their jacobian and velocity error (bias included), and accept the resulting impulses
+    virtual std::size_t direct_rows() const;
+    virtual void direct_jacobian(jacobian_row2D *rows) const;
+    virtual void direct_velocity_error(float *errors) const;
+    virtual void apply_direct_impulse(const float *impulses);
+
     bool is_constraint() const override final;
+    const constraint_kind2D *kind() const;
+    float impulse_delta() const; // magnitude of the impulse applied by the last velocity solve
+    virtual float accumulated_impulse() const; // magnitude of the impulse accumulated so far in the stage
 
     specs::constraint2D::properties cprops() const;
     void cprops(const specs::constraint2D::properties &cprops);
@@ -38,5 +82,11 @@ class constraint2D : virtual public joint2D
     bool m_is_soft;
     float m_frequency;
     float m_damping_ratio;
+    float m_impulse_delta = 0.f;
+
+  private:
+    const constraint_kind2D *m_kind = nullptr;
+
+    friend struct constraint_kind2D;
 };
 } // namespace ppx
\ No newline at end of file
@@ -37,6 +37,13 @@ template <Constraint2D T> class constraint_manager2D : public joint_manager2D<T>
         joint_manager2D<T>::s_name = name;
     }
 
+    virtual T *add(const typename T::specs &spc) override
+    {
+        T *constraint = joint_manager2D<T>::add(spc);
+        constraint_kind2D::assign(constraint);
+        return constraint;
+    }
+
   private:
     virtual void startup(std::vector<state2D> &states) override
     {
@@ -49,7 +56,7 @@ template <Constraint2D T> class constraint_manager2D : public joint_manager2D<T>
     {
         for (T *constraint : this->m_elements)
             if (constraint->enabled()) [[likely]]
-                constraint->solve_velocities();
+                constraint->T::solve_velocities();
     }
 
     virtual bool solve_positions() override
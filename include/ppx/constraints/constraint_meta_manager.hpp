@@ -11,9 +11,14 @@ class constraint_meta_manager2D final : public joint_meta_manager2D<iconstraint_
   public:
     specs::joint_manager2D::constraints2D params;
 
+    // iterations actually run per stage, soft step solves once per substep and does not correct positions
+    std::uint32_t velocity_iterations() const;
+    std::uint32_t position_iterations() const;
+
   private:
     using joint_meta_manager2D<iconstraint_manager2D>::joint_meta_manager2D;
     void solve_velocities(std::vector<state2D> &states);
+    void relax_velocities();
     void solve_positions(std::vector<state2D> &states);
 
     icontact_constraint_manager2D *m_contact_solver = nullptr;
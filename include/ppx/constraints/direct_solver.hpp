@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ppx/constraints/constraint.hpp"
+#include "ppx/body/state.hpp"
+
+namespace ppx
+{
+// Solves a set of hard equality constraints exactly, instead of iterating them Gauss-Seidel. The system J M^-1 J^T is
+// assembled once per stage and factorized with a skyline (envelope) LDL^T. Constraints are ordered with reverse
+// Cuthill-McKee first, which keeps the envelope of chains and trees narrow, so a chain of n links costs O(n) to factor
+// and to solve. Each solve measures the current velocity error of every constraint and applies the impulses that
+// cancel it all at once. Redundant rows (closed loops, constraints between non-dynamic bodies) get no impulse
+class direct_solver2D
+{
+  public:
+    void startup(std::vector<state2D> &states);
+    bool add(constraint2D *constraint); // returns false if the constraint must be iterated instead
+    void factorize();
+
+    float solve_velocities(); // returns the largest impulse change applied
+
+    const std::vector<constraint2D *> &constraints() const;
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    static inline constexpr double MIN_PIVOT = 1.e-9;
+
+    struct body_constraint
+    {
+        std::size_t body;
+        std::size_t constraint;
+    };
+
+    std::vector<state2D> *m_states = nullptr;
+    std::vector<constraint2D *> m_constraints;
+    std::vector<std::size_t> m_order;
+
+    std::vector<std::size_t> m_offsets; // first row of each constraint, in elimination order
+    std::vector<jacobian_row2D> m_jacobian;
+
+    std::vector<body_constraint> m_adjacency;
+    std::vector<std::size_t> m_first_row;
+    std::vector<std::size_t> m_envelope_start;
+    std::vector<double> m_envelope;
+    std::vector<double> m_inv_diagonal;
+    std::vector<double> m_scratch;
+
+    std::vector<float> m_errors;
+    std::vector<float> m_impulses;
+
+    void order_constraints();
+    void build_envelope();
+    void assemble();
+
+    double &entry(std::size_t row, std::size_t col);
+};
+} // namespace ppx
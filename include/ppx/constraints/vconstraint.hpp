@@ -65,25 +65,40 @@ class vconstraint2D : public constraint2D, public auxiliar_1D_direction<LinDegre
     virtual flat_t constraint_velocity() const = 0;
 
     virtual void solve_velocities() override;
+
+    // body data is gathered once per step. the constraint data is refreshed every stage, except when jacobians are
+    // frozen, in which case the data of the first stage of the step is reused by the rest
     virtual void startup(std::vector<state2D> &states) override;
     virtual void warmup();
 
     glm::vec2 reactive_force() const override final;
     float reactive_torque() const override final;
 
+    std::size_t direct_rows() const override final;
+    void direct_jacobian(jacobian_row2D *rows) const override final;
+    void direct_velocity_error(float *errors) const override final;
+    void apply_direct_impulse(const float *impulses) override final;
+
+    float accumulated_impulse() const override final;
+
   protected:
     virtual void update_constraint_data();
 
+    // only equality constraints whose velocity is exactly the jacobian times the body velocities may be solved directly
+    virtual bool is_equality() const;
+    virtual flat_t biased_constraint_velocity() const;
+
     virtual square_t mass() const;
     square_t default_inverse_mass() const;
 
-    virtual flat_t compute_constraint_impulse() const;
+    flat_t compute_constraint_impulse() const;
     glm::vec2 compute_linear_impulse(const flat_t &cimpulse) const;
     float compute_angular_impulse(const flat_t &cimpulse) const;
 
     void apply_linear_impulse(const glm::vec2 &linimpulse);
     void apply_angular_impulse(float angimpulse);
     void solve_velocities_clamped(const flat_t &min, const flat_t &max);
+    void apply_constraint_impulse(const flat_t &impulse);
 
     const state2D &state1() const;
     const state2D &state2() const;
@@ -107,5 +122,10 @@ class vconstraint2D : public constraint2D, public auxiliar_1D_direction<LinDegre
     bool m_dyn2;
 
     float m_ts;
+
+  private:
+    std::uint32_t m_startup_step = UINT32_MAX;
+    float m_mass_ts = 0.f;
+    bool m_stale_mass = true;
 };
 } // namespace ppx
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace ppx
+{
+// Greedy graph coloring of the constraints of an island. Two items sharing a dynamic body never end up with the same
+// color, so every item of a color can be solved concurrently. Items that find no free color among the first
+// MAX_COLORS (typically those attached to a very connected body) go to an overflow set that must be solved serially
+class constraint_coloring2D
+{
+  public:
+    static inline constexpr std::size_t MAX_COLORS = 24;
+
+    void begin(std::size_t body_count);
+    void add(std::size_t item, std::size_t index1, std::size_t index2, bool dynamic1, bool dynamic2);
+
+    const std::vector<std::vector<std::size_t>> &colors() const;
+    const std::vector<std::size_t> &overflow() const;
+
+  private:
+    std::vector<std::uint32_t> m_body_colors; // bitmask of used colors per body index
+    std::vector<std::size_t> m_touched_bodies;
+
+    std::vector<std::vector<std::size_t>> m_colors;
+    std::vector<std::size_t> m_overflow;
+};
+} // namespace ppx
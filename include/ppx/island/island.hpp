@@ -4,6 +4,9 @@
 #include "ppx/constraints/constraint.hpp"
 #include "ppx/body/body.hpp"
 #include "ppx/collision/contacts/contact.hpp"
+#include "ppx/collision/contacts/contact_solver.hpp"
+#include "ppx/constraints/direct_solver.hpp"
+#include "ppx/island/constraint_coloring.hpp"
 #include "kit/container/hashable_tuple.hpp"
 
 namespace ppx
@@ -25,16 +28,25 @@ class island2D : public worldref2D
 
     void solve_actuators(std::vector<state2D> &states);
 
-    void solve_velocity_constraints(std::vector<state2D> &states);
-    void solve_position_constraints(std::vector<state2D> &states);
+    void solve_velocity_constraints(std::vector<state2D> &states, bool colored = false);
+    void relax_velocity_constraints(bool colored = false);
+    void solve_position_constraints();
 
     float time_still() const;
+    // sampled when positions are integrated, before the xpbd, relax and position passes of the step
     float energy() const;
+    float max_speed() const; // of the last substep
     bool solved_positions() const;
 
+    // iterations and residual of the last velocity solve
+    std::uint32_t velocity_iterations() const;
+    float velocity_residual() const;
+
     const std::vector<body2D *> &bodies() const;
-    const std::vector<actuator2D *> &actuators() const;
+    const std::vector<actuator2D *> &actuators() const; // joints only. actuator based contacts are solved globally
+    // joints and constraint based contacts other than nonpen contacts, which are packed apart for the contact solver
     const std::vector<constraint2D *> &constraints() const;
+    const std::vector<nonpen_contact2D *> &packed_contacts() const;
 
     bool checksum() const;
 
@@ -47,27 +59,15 @@ class island2D : public worldref2D
         if constexpr (!Contact2D<Joint>)
             island->awake();
         else
-        {
-            KIT_ASSERT_ERROR(std::find(island->m_contacts.begin(), island->m_contacts.end(), joint) ==
-                                 island->m_contacts.end(),
-                             "Contact already exists on island")
-            island->m_contacts.push_back(joint);
-        }
-
-        if constexpr (IConstraint2D<Joint>)
-        {
-            KIT_ASSERT_ERROR(std::find(island->m_constraints.begin(), island->m_constraints.end(), joint) ==
-                                 island->m_constraints.end(),
-                             "Joint already exists on island")
-            island->m_constraints.push_back(joint);
-        }
-        else
-        {
-            KIT_ASSERT_ERROR(std::find(island->m_actuators.begin(), island->m_actuators.end(), joint) ==
-                                 island->m_actuators.end(),
-                             "Joint already exists on island")
-            island->m_actuators.push_back(joint);
-        }
+            push_back(island->m_contacts, joint, &joint2D::metadata::island_contact_slot);
+
+        // actuator based contacts are solved by their manager in a single pass, so islands only track them
+        if constexpr (std::is_same_v<Joint, nonpen_contact2D>)
+            push_back(island->m_packed_contacts, joint, &joint2D::metadata::island_slot);
+        else if constexpr (IConstraint2D<Joint>)
+            push_back(island->m_constraints, joint, &joint2D::metadata::island_slot);
+        else if constexpr (!Contact2D<Joint>)
+            push_back(island->m_actuators, joint, &joint2D::metadata::island_slot);
     }
 
     template <IJoint2D Joint> static void remove(Joint *joint)
@@ -84,45 +84,33 @@ class island2D : public worldref2D
                          "The joint's bodies must share the same island");
         if (!island)
             return;
+        bool found = false;
         if constexpr (Contact2D<Joint>)
         {
             island->m_lost_contact = true;
-            for (std::size_t i = 0; i < island->m_contacts.size(); i++)
-                if (island->m_contacts[i] == joint)
-                {
-                    island->m_contacts.erase(island->m_contacts.begin() + i);
-                    break;
-                }
+            found = swap_remove(island->m_contacts, joint, &joint2D::metadata::island_contact_slot);
         }
 
-        if constexpr (IConstraint2D<Joint>)
+        if constexpr (std::is_same_v<Joint, nonpen_contact2D>)
+            found = swap_remove(island->m_packed_contacts, joint, &joint2D::metadata::island_slot);
+        else if constexpr (IConstraint2D<Joint>)
+            found = swap_remove(island->m_constraints, joint, &joint2D::metadata::island_slot);
+        else if constexpr (!Contact2D<Joint>)
+            found = swap_remove(island->m_actuators, joint, &joint2D::metadata::island_slot);
+        if (!found)
         {
-            for (std::size_t i = 0; i < island->m_constraints.size(); i++)
-                if (island->m_constraints[i] == joint)
-                {
-                    island->m_constraints.erase(island->m_constraints.begin() + i);
-                    if (!Contact2D<Joint> || !body2->is_dynamic() || island != body2->meta.island)
-                        island->awake();
-                    if constexpr (!Contact2D<Joint>)
-                        island->m_may_split |= body2->is_dynamic();
-                    return;
-                }
+            KIT_WARN("Joint not found in island");
+            return;
         }
-        else
-            for (std::size_t i = 0; i < island->m_actuators.size(); i++)
-                if (island->m_actuators[i] == joint)
-                {
-                    island->m_actuators.erase(island->m_actuators.begin() + i);
-                    if (!Contact2D<Joint> || !body2->is_dynamic() || island != body2->meta.island)
-                        island->awake();
-                    if constexpr (!Contact2D<Joint>)
-                        island->m_may_split |= body2->is_dynamic();
-                    return;
-                }
-        KIT_WARN("Joint not found in island");
+
+        if (!Contact2D<Joint> || !body2->is_dynamic() || island != body2->meta.island)
+            island->awake();
+        if constexpr (!Contact2D<Joint>)
+            island->m_may_split |= body2->is_dynamic();
     }
 
     std::size_t size() const;
+    std::size_t estimated_cost() const; // rough work of a substep: rows times the iterations of the last solve
     bool is_void() const;
     bool no_bodies() const;
     bool no_joints() const;
@@ -148,6 +136,75 @@ class island2D : public worldref2D
     }
 
     static island2D *handle_island_merge_encounter(island2D *island1, island2D *island2);
+    void reindex();
+    void sort_by_bodies(); // by their lowest body index
+
+    // union find over the island slots of the bodies, linked by every joint and contact between two dynamic bodies.
+    // returns the number of connected components, and labels every slot with its component (0 for the first body) if
+    // there is more than one. it only touches the island, so many islands can run it in parallel
+    std::size_t find_components();
+    std::size_t component_root(std::size_t slot);
+    std::size_t component_of(const joint2D *joint) const;
+
+    // the items of a color split into joints and contact units, so that contact units can be solved in SIMD
+    // groups. tasks below joints.size() index a joint, the rest are offsets into units, one chunk each
+    static inline constexpr std::size_t UNITS_PER_TASK = 64; // a multiple of every SIMD width
+
+    struct color_batch
+    {
+        std::vector<std::size_t> joints;
+        std::vector<std::size_t> units;
+        std::vector<std::size_t> tasks;
+        std::vector<float> residuals; // one per task
+    };
+
+    // enabled constraints grouped by concrete type, so that each group is solved through a single static dispatch
+    struct kind_batch
+    {
+        const constraint_kind2D *kind;
+        std::vector<constraint2D *> constraints;
+    };
+
+    std::uint32_t velocity_iteration_cap() const;
+    float largest_impulse() const;
+
+    // sweeps return the largest impulse change they applied
+    float solve_sweep();
+
+    void build_kind_batches(bool direct);
+    float solve_kind_batch(const kind_batch &batch);
+
+    void build_coloring(std::size_t body_count);
+    float solve_colored_sweep();
+    float solve_colored_item(std::size_t item);
+    void solve_color_task(color_batch &batch, std::size_t task);
+
+    // every element remembers its position in the island vectors it belongs to, so that removals are O(1) swaps. the
+    // order of the vectors is therefore not stable
+    template <typename T, typename U, typename Meta>
+    static void push_back(std::vector<T *> &elements, U *element, std::size_t Meta::*slot)
+    {
+        element->meta.*slot = elements.size();
+        elements.push_back(element);
+    }
+    template <typename T, typename U, typename Meta>
+    static void append(std::vector<T *> &elements, const std::vector<U *> &other, std::size_t Meta::*slot)
+    {
+        for (U *element : other)
+            push_back(elements, element, slot);
+    }
+    template <typename T, typename U, typename Meta>
+    static bool swap_remove(std::vector<T *> &elements, const U *element, std::size_t Meta::*slot)
+    {
+        const std::size_t index = element->meta.*slot;
+        if (index >= elements.size() || elements[index] != element)
+            return false;
+        T *last = elements.back();
+        elements[index] = last;
+        last->meta.*slot = index;
+        elements.pop_back();
+        return true;
+    }
 
     std::vector<body2D *> m_bodies;
 
@@ -155,9 +212,30 @@ class island2D : public worldref2D
     std::vector<constraint2D *> m_constraints;
     std::vector<contact2D *> m_contacts;
 
-    std::uint32_t m_split_points = 0;
+    // nonpen contacts are kept apart from the rest of the constraints so they can be solved as packed rows
+    std::vector<nonpen_contact2D *> m_packed_contacts;
+    contact_solver2D m_contact_solver;
+    std::vector<kind_batch> m_kind_batches;
+
+    // hard equality joints solved exactly when the direct joint solver is enabled (not in colored islands)
+    direct_solver2D m_direct_solver;
+
+    // large islands solve their velocity constraints color by color, in parallel
+    constraint_coloring2D m_coloring;
+    std::vector<color_batch> m_color_batches;
+    bool m_colored = false;
+
+    std::uint32_t m_velocity_iterations = 0;
+    float m_velocity_residual = 0.f;
+
+    std::vector<std::size_t> m_components; // union find parents, indexed by body island slot
+    std::size_t m_component_count = 1;
+    std::vector<island2D *> m_split_targets; // one island per component, the first being this one
+
+    std::size_t m_awake_index = SIZE_MAX; // into the awake islands of the current substep
     float m_time_still = 0.f;
     float m_energy = 0.f;
+    float m_max_speed = 0.f;
     bool m_solved_positions = false;
     bool m_asleep = false;
     bool m_merged = false;
@@ -24,25 +24,59 @@ class island_manager2D final : public manager2D<island2D>
     specs::island_manager2D params;
 
   private:
+    // islands cheaper than this are batched together into a single task
+    static inline constexpr std::size_t MIN_TASK_COST = 256;
+
+    struct island_task
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // per awake island, accumulated while positions are integrated. velocities are thus sampled before the xpbd,
+    // relax and position passes of the step correct them
+    struct motion2D
+    {
+        float energy = 0.f; // of the bodies without a sleep velocity threshold
+        std::uint32_t energy_bodies = 0;
+        std::uint32_t restless_bodies = 0; // bodies above their own sleep velocity threshold
+        float max_speed2 = 0.f; // squared
+    };
+
     void solve_actuators(std::vector<state2D> &states);
 
     void solve_velocity_constraints(std::vector<state2D> &states);
-    void solve_position_constraints(std::vector<state2D> &states);
+    void relax_velocity_constraints();
+    void solve_position_constraints();
 
     island2D *create_and_add();
-    island2D *create_island_from_body(body2D *body);
+    island2D *create_island_from_body(body2D *body, std::uint32_t epoch);
 
-    void try_split();
+    void split_islands();
     void remove_invalid_and_gather_awake();
 
-    bool split(island2D *island);
+    void create_split_targets(island2D *island);
+    static void split(island2D *island);
+    void build_schedule();
+    bool reorder_due();
+    void sort_by_bodies();
+    void record_motion(const body2D *body, const state2D &state);
+    template <typename Pass> void run_scheduled(Pass &&pass);
+    template <typename Pass> void run_velocity_pass(Pass &&pass);
     void build_from_existing_simulation();
 
     bool m_enable = true;
-    std::size_t m_remove_index = 0;
-    std::vector<island2D *> m_awake_islands;
+    std::vector<island2D *> m_awake_islands; // sorted by estimated cost, largest first
+    std::vector<island_task> m_tasks;
+    std::vector<std::pair<std::size_t, island2D *>> m_costs;
+    std::vector<motion2D> m_motion; // indexed by awake island
+    std::vector<std::size_t> m_workers;
+    std::vector<island2D *> m_split_candidates;
+    std::uint32_t m_epoch = 0;
+    bool m_layout_changed = false; // islands were created, merged or lost bodies since the last reorder
 
     friend class world2D;
+    friend class island2D;
     friend class body2D;
     friend class body_manager2D;
 };
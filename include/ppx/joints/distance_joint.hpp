@@ -30,6 +30,7 @@ class distance_joint2D final : public pvconstraint2D<1, 0>, kit::non_copyable
 
   private:
     void update_constraint_data() override;
+    bool is_equality() const override;
     glm::vec2 direction() const override;
 
     float m_min_distance;
@@ -28,7 +28,14 @@ class joint2D : public kit::toggleable, public worldref2D
     struct metadata
     {
         std::size_t index;
-        bool island_flag = false;
+        std::uint32_t island_epoch = 0; // visited by the island flood fill of that epoch
+
+        // positions inside the owning containers, kept up to date so that removals are O(1)
+        std::size_t body_slot1 = 0;
+        std::size_t body_slot2 = 0;
+        std::size_t island_slot = 0;
+        std::size_t island_contact_slot = 0;
+        std::size_t dormant_slot = SIZE_MAX; // contacts parked by the contact manager while their island sleeps
     } meta;
 
     const body2D *body1() const;
@@ -55,6 +62,9 @@ class joint2D : public kit::toggleable, public worldref2D
     bool bodies_collide() const;
     void bodies_collide(bool bodies_collide);
 
+    bool position_based() const;
+    void position_based(bool position_based);
+
     specs::joint2D::properties jprops() const;
     void jprops(const specs::joint2D::properties &jprops);
 
@@ -86,6 +96,7 @@ class joint2D : public kit::toggleable, public worldref2D
     glm::vec2 m_lanchor2;
 
     bool m_bodies_collide;
+    bool m_position_based;
 
     glm::vec2 m_ganchor1;
     glm::vec2 m_ganchor2;
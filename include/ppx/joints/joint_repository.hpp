@@ -2,6 +2,7 @@
 
 #include "ppx/constraints/constraint_meta_manager.hpp"
 #include "ppx/actuators/actuator_meta_manager.hpp"
+#include "ppx/joints/xpbd_solver.hpp"
 
 namespace ppx
 {
@@ -10,6 +11,7 @@ class joint_repository2D final : public manager2D<joint2D>
   public:
     actuator_meta_manager2D actuators;
     constraint_meta_manager2D constraints;
+    xpbd_solver2D xpbd;
 
     template <Joint2D T> T *add(const typename T::specs &spc)
     {
@@ -18,5 +18,8 @@ class revolute_joint2D final : public pvconstraint2D<2, 0>, kit::non_copyable
 
     specs::properties props() const;
     void props(const specs::properties &props);
+
+  private:
+    bool is_equality() const override;
 };
 } // namespace ppx
\ No newline at end of file
@@ -21,5 +21,7 @@ class weld_joint2D final : public pvconstraint2D<2, 1>, kit::non_copyable
 
   private:
     float m_target_relangle;
+
+    bool is_equality() const override;
 };
 } // namespace ppx
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ppx/internal/worldref.hpp"
+#include "ppx/body/state.hpp"
+#include "ppx/island/constraint_coloring.hpp"
+
+namespace ppx
+{
+class joint2D;
+
+// Extended position based dynamics for the spring, distance and ball joints flagged as position based. Every substep,
+// once positions are integrated, their distance and angle ranges are projected directly on the positions with
+// compliance (the inverse of the stiffness given by their frequency), and the body velocities are corrected with the
+// resulting displacements. Hard joints have zero compliance. The joints are gathered and colored once per step, so
+// that the rows of a color can be projected in parallel
+class xpbd_solver2D : public worldref2D
+{
+  public:
+    using worldref2D::worldref2D;
+
+    specs::joint_manager2D::xpbd2D params;
+
+    void solve(std::vector<state2D> &states, float timestep);
+    std::size_t size() const;
+
+  private:
+    struct row
+    {
+        std::size_t index1;
+        std::size_t index2;
+        glm::vec2 lanchor1;
+        glm::vec2 lanchor2;
+
+        float imass1;
+        float imass2;
+        float iinertia1;
+        float iinertia2;
+
+        float min;
+        float max;
+        float compliance;
+        float damping;
+        float lambda;
+        bool angular;
+
+        // non-dynamic bodies are shared by rows of the same color, so they must never be written to
+        bool dyn1;
+        bool dyn2;
+    };
+
+    std::vector<row> m_rows;
+    constraint_coloring2D m_coloring;
+    std::uint32_t m_gather_step = UINT32_MAX;
+
+    void gather(const std::vector<state2D> &states);
+    bool fill_row(row &rw, const joint2D *joint, const std::vector<state2D> &states, float min, float max,
+                  float frequency, float damping_ratio, bool angular) const;
+
+    void project(row &rw, std::vector<state2D> &states, float timestep) const;
+    void project_distance(row &rw, state2D &state1, state2D &state2, float timestep) const;
+    void project_angle(row &rw, state2D &state1, state2D &state2, float timestep) const;
+    float lambda_step(row &rw, float c, float cvel, float inv_mass, float timestep) const;
+};
+} // namespace ppx
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ppx/world.hpp"
+#include "ppx/behaviours/interaction.hpp"
 #include "ppx/joints/rotor_joint.hpp"
 #include "ppx/joints/motor_joint.hpp"
 #include "ppx/joints/distance_joint.hpp"
@@ -24,6 +25,30 @@
 #include "kit/serialization/yaml/codec.hpp"
 #include "kit/serialization/yaml/glm.hpp"
 
+template <> struct kit::yaml::codec<ppx::specs::interaction2D>
+{
+    static YAML::Node encode(const ppx::specs::interaction2D &params)
+    {
+        YAML::Node node;
+        node["Enabled"] = params.barnes_hut;
+        node["Opening angle"] = params.opening_angle;
+        node["Leaf capacity"] = params.leaf_capacity;
+        node["Multithreading"] = params.multithreading;
+        return node;
+    }
+    static bool decode(const YAML::Node &node, ppx::specs::interaction2D &params)
+    {
+        if (!node.IsMap() || node.size() < 4)
+            return false;
+
+        params.barnes_hut = node["Enabled"].as<bool>();
+        params.opening_angle = node["Opening angle"].as<float>();
+        params.leaf_capacity = node["Leaf capacity"].as<std::uint32_t>();
+        params.multithreading = node["Multithreading"].as<bool>();
+        return true;
+    }
+};
+
 template <> struct kit::yaml::codec<ppx::behaviour2D>
 {
     static YAML::Node encode(const ppx::behaviour2D &bhv)
@@ -34,6 +59,8 @@ template <> struct kit::yaml::codec<ppx::behaviour2D>
         for (const auto &body : bhv)
             node["Bodies"].push_back(body->meta.index);
         node["Bodies"].SetStyle(YAML::EmitterStyle::Flow);
+        if (const auto interaction = dynamic_cast<const ppx::interaction2D *>(&bhv))
+            node["Barnes-Hut"] = interaction->params;
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::behaviour2D &bhv)
@@ -45,6 +72,8 @@ template <> struct kit::yaml::codec<ppx::behaviour2D>
         bhv.enabled(node["Enabled"].as<bool>());
         for (const YAML::Node &n : node["Bodies"])
             bhv.add(bhv.world.bodies[n.as<std::size_t>()]);
+        if (const auto interaction = dynamic_cast<ppx::interaction2D *>(&bhv); interaction && node["Barnes-Hut"])
+            interaction->params = node["Barnes-Hut"].as<ppx::specs::interaction2D>();
         return true;
     }
 };
@@ -58,6 +87,7 @@ template <> struct kit::yaml::codec<ppx::collider2D::specs::properties>
         node["Charge density"] = props.charge_density;
         node["Restitution"] = props.restitution;
         node["Friction"] = props.friction;
+        node["Material"] = props.material;
         node["Shape"] = (int)props.shape;
         switch (props.shape)
         {
@@ -79,6 +109,8 @@ template <> struct kit::yaml::codec<ppx::collider2D::specs::properties>
         props.charge_density = node["Charge density"].as<float>();
         props.restitution = node["Restitution"].as<float>();
         props.friction = node["Friction"].as<float>();
+        if (node["Material"])
+            props.material = node["Material"].as<std::uint32_t>();
         props.shape = (ppx::collider2D::stype)node["Shape"].as<int>();
         if (node["Radius"])
         {
@@ -127,6 +159,8 @@ template <> struct kit::yaml::codec<ppx::body2D::specs::properties>
         node["Mass"] = props.mass;
         node["Charge"] = props.charge;
         node["Type"] = (int)props.type;
+        node["Sleep velocity threshold"] = props.sleep_velocity_threshold;
+        node["Sleep angular velocity threshold"] = props.sleep_angular_velocity_threshold;
         for (const ppx::collider2D::specs &collider : props.colliders)
             node["Colliders"].push_back(collider);
         return node;
@@ -140,6 +174,10 @@ template <> struct kit::yaml::codec<ppx::body2D::specs::properties>
         props.mass = node["Mass"].as<float>();
         props.charge = node["Charge"].as<float>();
         props.type = (ppx::body2D::btype)node["Type"].as<int>();
+        if (node["Sleep velocity threshold"])
+            props.sleep_velocity_threshold = node["Sleep velocity threshold"].as<float>();
+        if (node["Sleep angular velocity threshold"])
+            props.sleep_angular_velocity_threshold = node["Sleep angular velocity threshold"].as<float>();
         if (node["Colliders"])
             for (const YAML::Node &n : node["Colliders"])
                 props.colliders.push_back(n.as<ppx::collider2D::specs>());
@@ -181,6 +219,7 @@ template <> struct kit::yaml::codec<ppx::specs::joint2D::properties>
     {
         YAML::Node node;
         node["Bodies collide"] = props.bodies_collide;
+        node["Position based"] = props.position_based;
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::specs::joint2D::properties &props)
@@ -189,6 +228,8 @@ template <> struct kit::yaml::codec<ppx::specs::joint2D::properties>
             return false;
 
         props.bodies_collide = node["Bodies collide"].as<bool>();
+        if (node["Position based"])
+            props.position_based = node["Position based"].as<bool>();
         return true;
     }
 };
@@ -749,6 +790,9 @@ template <> struct kit::yaml::codec<ppx::collision_manager2D>
 
         YAML::Node nnarrow = node["Narrow"];
         nnarrow["Name"] = cm.narrow()->name();
+        nnarrow["Multithreading"] = cm.narrow()->params.multithreading;
+        nnarrow["Speculative contacts"] = cm.narrow()->params.speculative_contacts;
+        nnarrow["Speculative margin"] = cm.narrow()->params.speculative_margin;
         if (auto narrow = cm.narrow<ppx::gjk_epa_narrow2D>())
         {
             nnarrow["Method"] = 0;
@@ -759,6 +803,9 @@ template <> struct kit::yaml::codec<ppx::collision_manager2D>
 
         YAML::Node nsolv = node["Contacts"];
         nsolv["Contact lifetime"] = cm.contact_manager()->params.contact_lifetime;
+        nsolv["Persistent impulses"] = cm.contact_manager()->params.persistent_impulses;
+        nsolv["Multithreading"] = cm.contact_manager()->params.multithreading;
+        nsolv["Impulse match distance"] = cm.contact_manager()->params.impulse_match_distance;
         if (auto colsolv = cm.contact_manager<ppx::contact_constraint_manager2D<ppx::nonpen_contact2D>>())
             nsolv["Solver method"] = 0;
         else if (auto colsolv = cm.contact_manager<ppx::contact_actuator_manager2D<ppx::spring_contact2D>>())
@@ -767,6 +814,26 @@ template <> struct kit::yaml::codec<ppx::collision_manager2D>
         nsolv["Rigidity"] = ppx::spring_contact2D::rigidity;
         nsolv["Max normal damping"] = ppx::spring_contact2D::max_normal_damping;
         nsolv["Max tangent damping"] = ppx::spring_contact2D::max_tangent_damping;
+
+        for (std::uint32_t i = 1; i < cm.materials.size(); i++)
+        {
+            const ppx::material2D &mat = cm.materials[i];
+            YAML::Node nmat;
+            nmat["Friction"] = mat.friction;
+            nmat["Restitution"] = mat.restitution;
+            nmat["Friction combine"] = (int)mat.friction_combine;
+            nmat["Restitution combine"] = (int)mat.restitution_combine;
+            node["Materials"].push_back(nmat);
+        }
+        for (const auto &ovr : cm.materials.overrides())
+        {
+            YAML::Node novr;
+            novr["Material 1"] = ovr.id1;
+            novr["Material 2"] = ovr.id2;
+            novr["Friction"] = ovr.props.friction;
+            novr["Restitution"] = ovr.props.restitution;
+            node["Material overrides"].push_back(novr);
+        }
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::collision_manager2D &cm)
@@ -799,6 +866,12 @@ template <> struct kit::yaml::codec<ppx::collision_manager2D>
             else if (method == 1)
                 cm.set_narrow<ppx::sat_narrow2D>();
         }
+        if (nnarrow["Speculative contacts"])
+        {
+            cm.narrow()->params.multithreading = nnarrow["Multithreading"].as<bool>();
+            cm.narrow()->params.speculative_contacts = nnarrow["Speculative contacts"].as<bool>();
+            cm.narrow()->params.speculative_margin = nnarrow["Speculative margin"].as<float>();
+        }
 
         const YAML::Node nsolv = node["Contacts"];
         if (nsolv["Solver method"])
@@ -810,10 +883,35 @@ template <> struct kit::yaml::codec<ppx::collision_manager2D>
                 cm.set_contact_manager<ppx::contact_actuator_manager2D<ppx::spring_contact2D>>();
         }
         cm.contact_manager()->params.contact_lifetime = nsolv["Contact lifetime"].as<std::uint32_t>();
+        if (nsolv["Persistent impulses"])
+            cm.contact_manager()->params.persistent_impulses = nsolv["Persistent impulses"].as<bool>();
+        if (nsolv["Multithreading"])
+            cm.contact_manager()->params.multithreading = nsolv["Multithreading"].as<bool>();
+        if (nsolv["Impulse match distance"])
+            cm.contact_manager()->params.impulse_match_distance = nsolv["Impulse match distance"].as<float>();
 
         ppx::spring_contact2D::rigidity = nsolv["Rigidity"].as<float>();
         ppx::spring_contact2D::max_normal_damping = nsolv["Max normal damping"].as<float>();
         ppx::spring_contact2D::max_tangent_damping = nsolv["Max tangent damping"].as<float>();
+
+        cm.materials.clear();
+        if (node["Materials"])
+            for (const YAML::Node &nmat : node["Materials"])
+            {
+                ppx::material2D mat;
+                mat.friction = nmat["Friction"].as<float>();
+                mat.restitution = nmat["Restitution"].as<float>();
+                mat.friction_combine = (ppx::material2D::combine_mode)nmat["Friction combine"].as<int>();
+                mat.restitution_combine = (ppx::material2D::combine_mode)nmat["Restitution combine"].as<int>();
+                cm.materials.add(mat);
+            }
+        if (node["Material overrides"])
+            for (const YAML::Node &novr : node["Material overrides"])
+            {
+                const std::uint32_t id1 = novr["Material 1"].as<std::uint32_t>();
+                const std::uint32_t id2 = novr["Material 2"].as<std::uint32_t>();
+                cm.materials.override_pair(id1, id2, {novr["Friction"].as<float>(), novr["Restitution"].as<float>()});
+            }
         return true;
     }
 };
@@ -832,6 +930,13 @@ template <> struct kit::yaml::codec<ppx::specs::joint_manager2D::constraints2D>
         node["Slop"] = params.slop;
         node["Max position correction"] = params.max_position_correction;
         node["Position resolution speed"] = params.position_resolution_speed;
+        node["Soft step"] = params.soft_step;
+        node["Substeps"] = params.substeps;
+        node["Max contact push velocity"] = params.max_contact_push_velocity;
+        node["Adaptive iterations"] = params.adaptive_iterations;
+        node["Velocity tolerance"] = params.velocity_tolerance;
+        node["Freeze jacobians"] = params.freeze_jacobians;
+        node["Direct joint solver"] = params.direct_joint_solver;
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::specs::joint_manager2D::constraints2D &params)
@@ -848,6 +953,40 @@ template <> struct kit::yaml::codec<ppx::specs::joint_manager2D::constraints2D>
         params.slop = node["Slop"].as<float>();
         params.max_position_correction = node["Max position correction"].as<float>();
         params.position_resolution_speed = node["Position resolution speed"].as<float>();
+        if (node["Soft step"])
+            params.soft_step = node["Soft step"].as<bool>();
+        if (node["Substeps"])
+            params.substeps = node["Substeps"].as<std::uint32_t>();
+        if (node["Max contact push velocity"])
+            params.max_contact_push_velocity = node["Max contact push velocity"].as<float>();
+        if (node["Adaptive iterations"])
+            params.adaptive_iterations = node["Adaptive iterations"].as<bool>();
+        if (node["Velocity tolerance"])
+            params.velocity_tolerance = node["Velocity tolerance"].as<float>();
+        if (node["Freeze jacobians"])
+            params.freeze_jacobians = node["Freeze jacobians"].as<bool>();
+        if (node["Direct joint solver"])
+            params.direct_joint_solver = node["Direct joint solver"].as<bool>();
+        return true;
+    }
+};
+
+template <> struct kit::yaml::codec<ppx::specs::joint_manager2D::xpbd2D>
+{
+    static YAML::Node encode(const ppx::specs::joint_manager2D::xpbd2D &params)
+    {
+        YAML::Node node;
+        node["Iterations"] = params.iterations;
+        node["Multithreading"] = params.multithreading;
+        return node;
+    }
+    static bool decode(const YAML::Node &node, ppx::specs::joint_manager2D::xpbd2D &params)
+    {
+        if (!node.IsMap() || node.size() < 2)
+            return false;
+
+        params.iterations = node["Iterations"].as<std::uint32_t>();
+        params.multithreading = node["Multithreading"].as<bool>();
         return true;
     }
 };
@@ -863,6 +1002,8 @@ template <> struct kit::yaml::codec<ppx::specs::island_manager2D>
         node["Upper sleep energy threshold"] = params.upper_sleep_energy_threshold;
         node["Body count mid threshold reference"] = params.body_count_mid_threshold_reference;
         node["Sleep time threshold"] = params.sleep_time_threshold;
+        node["Coloring body threshold"] = params.coloring_body_threshold;
+        node["Reorder interval"] = params.reorder_interval;
         return node;
     }
     static bool decode(const YAML::Node &node, ppx::specs::island_manager2D &params)
@@ -876,6 +1017,10 @@ template <> struct kit::yaml::codec<ppx::specs::island_manager2D>
         params.upper_sleep_energy_threshold = node["Upper sleep energy threshold"].as<float>();
         params.body_count_mid_threshold_reference = node["Body count mid threshold reference"].as<std::uint32_t>();
         params.sleep_time_threshold = node["Sleep time threshold"].as<float>();
+        if (node["Coloring body threshold"])
+            params.coloring_body_threshold = node["Coloring body threshold"].as<std::uint32_t>();
+        if (node["Reorder interval"])
+            params.reorder_interval = node["Reorder interval"].as<std::uint32_t>();
         return true;
     }
 };
@@ -886,6 +1031,7 @@ template <> struct kit::yaml::codec<ppx::world2D>
     {
         YAML::Node node;
         node["Constraint settings"] = world.joints.constraints.params;
+        node["XPBD settings"] = world.joints.xpbd.params;
         node["Island settings"] = world.islands.params;
         node["Island settings"]["Enabled"] = world.islands.enabled();
         node["Behaviour manager"] = world.behaviours;
@@ -913,6 +1059,8 @@ template <> struct kit::yaml::codec<ppx::world2D>
         node["Joints repository"].as<ppx::joint_repository2D>(world.joints);
 
         world.joints.constraints.params = node["Constraint settings"].as<ppx::specs::joint_manager2D::constraints2D>();
+        if (node["XPBD settings"])
+            world.joints.xpbd.params = node["XPBD settings"].as<ppx::specs::joint_manager2D::xpbd2D>();
         world.islands.params = node["Island settings"].as<ppx::specs::island_manager2D>();
         world.islands.enabled(node["Island settings"]["Enabled"].as<bool>());
 
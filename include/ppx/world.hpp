@@ -53,6 +53,9 @@ class world2D : kit::non_copyable
 
     void pre_step();
     void post_step();
+
+    bool soft_step();
+    void solve_substep(std::vector<state2D> &states, float timestep);
 };
 
 } // namespace ppx
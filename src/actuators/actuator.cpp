@@ -12,25 +12,28 @@ bool actuator2D::is_actuator() const
 
 void actuator2D::solve(std::vector<state2D> &states)
 {
-    const std::size_t index1 = m_body1->meta.index;
-    const std::size_t index2 = m_body2->meta.index;
+    const wrench w = compute_wrench(states);
+    state2D &state1 = states[m_body1->meta.index];
+    state2D &state2 = states[m_body2->meta.index];
 
-    state2D &state1 = states[index1];
-    state2D &state2 = states[index2];
+    state1.substep_force -= w.force;
+    state1.substep_torque -= w.torque1;
+
+    state2.substep_force += w.force;
+    state2.substep_torque += w.torque2;
+}
+
+actuator2D::wrench actuator2D::compute_wrench(const std::vector<state2D> &states)
+{
+    const state2D &state1 = states[m_body1->meta.index];
+    const state2D &state2 = states[m_body2->meta.index];
 
     compute_anchors_and_offsets(state1, state2);
     const glm::vec3 f = compute_force(state1, state2);
     m_force = glm::vec2(f);
     m_torque = f.z;
 
-    const float t1 = kit::cross2D(m_offset1, m_force) + m_torque;
-    const float t2 = kit::cross2D(m_offset2, m_force) + m_torque;
-
-    state1.substep_force -= m_force;
-    state1.substep_torque -= t1;
-
-    state2.substep_force += m_force;
-    state2.substep_torque += t2;
+    return {m_force, kit::cross2D(m_offset1, m_force) + m_torque, kit::cross2D(m_offset2, m_force) + m_torque};
 }
 
 glm::vec2 actuator2D::reactive_force() const
@@ -7,10 +7,16 @@ namespace ppx
 void actuator_meta_manager2D::solve(std::vector<state2D> &states)
 {
     KIT_PERF_SCOPE("ppx::actuator_meta_manager2D::solve")
-    if (m_contact_solver)
-        m_contact_solver->solve(states);
+    solve_contacts(states);
     for (const auto &manager : m_elements)
         if (manager->enabled()) [[likely]]
             manager->solve(states);
 }
+
+// islands do not hold actuator based contacts, so these are always solved here, in parallel when there are enough
+void actuator_meta_manager2D::solve_contacts(std::vector<state2D> &states)
+{
+    if (m_contact_solver)
+        m_contact_solver->solve(states);
+}
 } // namespace ppx
\ No newline at end of file
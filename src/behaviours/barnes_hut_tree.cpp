@@ -0,0 +1,106 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/behaviours/barnes_hut_tree.hpp"
+
+namespace ppx
+{
+void barnes_hut_tree2D::build(const std::vector<const state2D *> &states, const std::uint32_t leaf_capacity)
+{
+    KIT_PERF_SCOPE("ppx::barnes_hut_tree2D::build")
+    m_states = states;
+    m_nodes.clear();
+    m_leaf_capacity = std::max(leaf_capacity, 1u);
+    if (m_states.empty())
+        return;
+
+    glm::vec2 min = m_states[0]->centroid.position;
+    glm::vec2 max = min;
+    for (const state2D *state : m_states)
+    {
+        min = glm::min(min, state->centroid.position);
+        max = glm::max(max, state->centroid.position);
+    }
+
+    node root;
+    root.center = 0.5f * (min + max);
+    root.half_size = 0.5f * std::max(max.x - min.x, max.y - min.y) + 1.e-3f;
+    root.begin = 0;
+    root.end = (std::uint32_t)m_states.size();
+    m_nodes.push_back(root);
+    subdivide(0, 0);
+}
+
+void barnes_hut_tree2D::subdivide(const std::uint32_t index, const std::uint32_t depth)
+{
+    aggregate(m_nodes[index]);
+    const node parent = m_nodes[index];
+    if (parent.end - parent.begin <= m_leaf_capacity || depth == MAX_DEPTH)
+        return;
+
+    // the range of the parent is partitioned in place into its four quadrants
+    const auto first = m_states.begin() + parent.begin;
+    const auto last = m_states.begin() + parent.end;
+    const glm::vec2 center = parent.center;
+    const auto below = [center](const state2D *state) { return state->centroid.position.y < center.y; };
+    const auto left = [center](const state2D *state) { return state->centroid.position.x < center.x; };
+
+    const auto mid = std::partition(first, last, below);
+    const std::array<decltype(mid), 5> bounds{first, std::partition(first, mid, left), mid,
+                                              std::partition(mid, last, left), last};
+
+    const std::uint32_t children = (std::uint32_t)m_nodes.size();
+    m_nodes[index].children = children;
+    const float quarter = 0.5f * parent.half_size;
+    for (std::uint32_t i = 0; i < 4; i++)
+    {
+        node child;
+        child.center = center + glm::vec2(i % 2 == 0 ? -quarter : quarter, i < 2 ? -quarter : quarter);
+        child.half_size = quarter;
+        child.begin = (std::uint32_t)(bounds[i] - m_states.begin());
+        child.end = (std::uint32_t)(bounds[i + 1] - m_states.begin());
+        m_nodes.push_back(child);
+    }
+    for (std::uint32_t i = 0; i < 4; i++)
+        subdivide(children + i, depth + 1);
+}
+
+// charge is placed at the center of the absolute charge, so that opposite charges do not cancel their position out
+void barnes_hut_tree2D::aggregate(node &nd) const
+{
+    float mass = 0.f;
+    float charge = 0.f;
+    float abs_charge = 0.f;
+    glm::vec2 mass_center{0.f};
+    glm::vec2 charge_center{0.f};
+    for (std::uint32_t i = nd.begin; i < nd.end; i++)
+    {
+        const state2D &state = *m_states[i];
+        mass += state.mass;
+        mass_center += state.mass * state.centroid.position;
+        charge += state.charge;
+        abs_charge += glm::abs(state.charge);
+        charge_center += glm::abs(state.charge) * state.charge_centroid;
+    }
+
+    state2D &agg = nd.aggregate;
+    agg.mass = mass;
+    agg.imass = mass > 0.f ? 1.f / mass : 0.f;
+    agg.charge = charge;
+    agg.centroid.position = mass > 0.f ? mass_center / mass : nd.center;
+    agg.charge_centroid = abs_charge > 0.f ? charge_center / abs_charge : agg.centroid.position;
+}
+
+bool barnes_hut_tree2D::node::contains(const glm::vec2 &point) const
+{
+    const glm::vec2 offset = glm::abs(point - center);
+    return offset.x <= half_size && offset.y <= half_size;
+}
+
+std::size_t barnes_hut_tree2D::size() const
+{
+    return m_nodes.size();
+}
+bool barnes_hut_tree2D::empty() const
+{
+    return m_nodes.empty();
+}
+} // namespace ppx
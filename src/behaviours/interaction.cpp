@@ -1,6 +1,7 @@
 #include "ppx/internal/pch.hpp"
 #include "ppx/behaviours/interaction.hpp"
 #include "ppx/world.hpp"
+#include "kit/multithreading/mt_for_each.hpp"
 
 namespace ppx
 {
@@ -31,6 +32,24 @@ float interaction2D::potential_energy(const state2D &state1) const
 }
 float interaction2D::potential_energy() const
 {
+    if (params.barnes_hut)
+    {
+        KIT_PERF_SCOPE("ppx::interaction2D::potential_energy")
+        m_sources.clear();
+        for (const body2D *body : m_elements)
+            m_sources.push_back(&body->state());
+        m_tree.build(m_sources, params.leaf_capacity);
+
+        // every pair is visited from both ends
+        float pot = 0.f;
+        for (const state2D *state : m_sources)
+            pot += m_tree.accumulate<float>(*state, params.opening_angle,
+                                            [this](const state2D &state1, const state2D &state2) {
+                                                return potential_energy_pair(state1, state2);
+                                            });
+        return 0.5f * pot;
+    }
+
     float pot = 0.f;
     for (std::size_t i = 0; i < m_elements.size(); i++)
         for (std::size_t j = i + 1; j < m_elements.size(); j++)
@@ -58,6 +77,40 @@ bool interaction2D::remove(std::size_t index)
     return true;
 }
 
+// the tree is built from the states of the whole world, the same sources the exact force sums over
+void interaction2D::load_forces(std::vector<state2D> &states) const
+{
+    if (!params.barnes_hut)
+    {
+        behaviour2D::load_forces(states);
+        return;
+    }
+    KIT_PERF_SCOPE("ppx::interaction2D::load_forces")
+    m_sources.clear();
+    for (const state2D &state : states)
+        m_sources.push_back(&state);
+    m_tree.build(m_sources, params.leaf_capacity);
+
+    // each body only writes to its own state, and the tree only reads positions, masses and charges
+    const auto lambda = [this, &states](const body2D *body) {
+        if (!body->is_dynamic() || body->asleep())
+            return;
+        state2D &state = states[body->meta.index];
+        const glm::vec3 f = m_tree.accumulate<glm::vec3>(
+            state, params.opening_angle,
+            [this](const state2D &state1, const state2D &state2) { return force_pair(state1, state2); });
+        state.substep_force += glm::vec2(f);
+        state.substep_torque += f.z;
+    };
+
+    const auto pool = world.thread_pool;
+    if (params.multithreading && pool)
+        kit::mt::for_each(*pool, m_elements.begin(), m_elements.end(), lambda, pool->thread_count());
+    else
+        for (const body2D *body : m_elements)
+            lambda(body);
+}
+
 glm::vec3 interaction2D::force(const state2D &state1) const
 {
     glm::vec3 total_force{0.f};
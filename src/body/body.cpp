@@ -16,29 +16,55 @@ body2D::body2D(world2D &world, const body2D::specs &spc)
     m_state.charge = spc.props.charge;
     m_state.charge_centroid = spc.position;
     m_state.type = spc.props.type;
+    m_sleep_velocity_threshold = spc.props.sleep_velocity_threshold;
+    m_sleep_angular_velocity_threshold = spc.props.sleep_angular_velocity_threshold;
     mass(spc.props.mass);
 }
 
+std::size_t &body2D::metadata::slot(joint2D *joint) const
+{
+    return &joint->body1()->meta == this ? joint->meta.body_slot1 : joint->meta.body_slot2;
+}
+std::size_t body2D::metadata::slot(const joint2D *joint) const
+{
+    return &joint->body1()->meta == this ? joint->meta.body_slot1 : joint->meta.body_slot2;
+}
+
+void body2D::metadata::add_joint(joint2D *joint)
+{
+    slot(joint) = joints.size();
+    joints.push_back(joint);
+}
+void body2D::metadata::add_contact(contact2D *contact)
+{
+    slot(contact) = contacts.size();
+    contacts.push_back(contact);
+}
+
 void body2D::metadata::remove_joint(const joint2D *joint)
 {
-    for (std::size_t i = 0; i < joints.size(); i++)
-        if (joints[i] == joint)
-        {
-            joints.erase(joints.begin() + i);
-            return;
-        }
-    KIT_WARN("Joint not found in body metadata")
+    const std::size_t index = slot(joint);
+    if (index >= joints.size() || joints[index] != joint)
+    {
+        KIT_WARN("Joint not found in body metadata")
+        return;
+    }
+    joints[index] = joints.back();
+    slot(joints[index]) = index;
+    joints.pop_back();
 }
 
 void body2D::metadata::remove_contact(const contact2D *contact)
 {
-    for (std::size_t i = 0; i < contacts.size(); i++)
-        if (contacts[i] == contact)
-        {
-            contacts.erase(contacts.begin() + i);
-            return;
-        }
-    KIT_WARN("Contact not found in body metadata")
+    const std::size_t index = slot(contact);
+    if (index >= contacts.size() || contacts[index] != contact)
+    {
+        KIT_WARN("Contact not found in body metadata")
+        return;
+    }
+    contacts[index] = contacts.back();
+    slot(contacts[index]) = index;
+    contacts.pop_back();
 }
 
 const collider2D *body2D::operator[](const std::size_t index) const
@@ -529,6 +555,26 @@ void body2D::charge(const float charge)
     awake();
 }
 
+float body2D::sleep_velocity_threshold() const
+{
+    return m_sleep_velocity_threshold;
+}
+void body2D::sleep_velocity_threshold(const float threshold)
+{
+    m_sleep_velocity_threshold = threshold;
+    awake();
+}
+
+float body2D::sleep_angular_velocity_threshold() const
+{
+    return m_sleep_angular_velocity_threshold;
+}
+void body2D::sleep_angular_velocity_threshold(const float threshold)
+{
+    m_sleep_angular_velocity_threshold = threshold;
+    awake();
+}
+
 float body2D::rotation() const
 {
     return m_state.centroid.rotation;
@@ -176,17 +176,43 @@ bool body_manager2D::remove(const std::size_t index)
     return true;
 }
 
+// the bodies of each island become contiguous, and bodies outside islands go last in their previous order. states are
+// gathered right after, so they follow the new order
+void body_manager2D::sort_by_island()
+{
+    KIT_PERF_SCOPE("ppx::body_manager2D::sort_by_island")
+    m_sorted.clear();
+    m_sorted.reserve(m_elements.size());
+    for (const island2D *island : world.islands)
+        for (body2D *body : island->bodies())
+            if (body->meta.island == island) // merged islands linger until the next substep
+                m_sorted.push_back(body);
+    for (body2D *body : m_elements)
+        if (!body->meta.island)
+            m_sorted.push_back(body);
+    KIT_ASSERT_ERROR(m_sorted.size() == m_elements.size(), "Body count mismatch after sorting by island")
+
+    std::swap(m_elements, m_sorted);
+    for (std::size_t i = 0; i < m_elements.size(); i++)
+        m_elements[i]->meta.index = i;
+    world.islands.sort_by_bodies();
+}
+
 void body_manager2D::gather_and_load_states(rk::state<float> &rkstate)
 {
     KIT_PERF_SCOPE("ppx::body_manager2D::gather_and_load_states")
     m_states.resize(m_elements.size());
-    rkstate.resize(6 * m_elements.size());
     for (std::size_t i = 0; i < m_elements.size(); i++)
-    {
         m_states[i] = m_elements[i]->state();
-        m_states[i].substep_force = glm::vec2(0.f);
-        m_states[i].substep_torque = 0.f;
+    reset_substep_forces();
+    load_states(rkstate);
+}
 
+void body_manager2D::load_states(rk::state<float> &rkstate) const
+{
+    rkstate.resize(6 * m_states.size());
+    for (std::size_t i = 0; i < m_states.size(); i++)
+    {
         const state2D &state = m_states[i];
         const std::size_t index = 6 * i;
 
@@ -220,6 +246,15 @@ void body_manager2D::update_states(const std::vector<float> &posvels)
     }
 }
 
+void body_manager2D::reset_substep_forces()
+{
+    for (state2D &state : m_states)
+    {
+        state.substep_force = glm::vec2(0.f);
+        state.substep_torque = 0.f;
+    }
+}
+
 void body_manager2D::integrate_velocities(const float ts)
 {
     KIT_PERF_SCOPE("ppx::body_manager2D::integrate_velocities")
@@ -236,13 +271,19 @@ void body_manager2D::integrate_velocities(const float ts)
     }
 }
 
+// the sleep statistics of the islands are gathered here, while the states are already being walked
 void body_manager2D::integrate_positions(const float ts)
 {
     KIT_PERF_SCOPE("ppx::body_manager2D::integrate_positions")
-    for (state2D &state : m_states)
+    island_manager2D &islands = world.islands;
+    const bool track_motion = islands.enabled() && islands.params.enable_sleep;
+    for (std::size_t i = 0; i < m_states.size(); i++)
     {
+        state2D &state = m_states[i];
         state.centroid.position += state.velocity * ts;
         state.centroid.rotation += state.angular_velocity * ts;
+        if (track_motion)
+            islands.record_motion(m_elements[i], state);
     }
 }
 
@@ -5,9 +5,10 @@
 namespace ppx
 {
 collider2D::collider2D(world2D &world, body2D *body, const specs &spc)
-    : worldref2D(world), restitution(spc.props.restitution), friction(spc.props.friction),
-      collision_filter(spc.props.collision_filter), m_position(spc.position), m_body(body),
-      m_density(spc.props.density), m_charge_density(spc.props.charge_density), m_type(spc.props.shape)
+    : worldref2D(world), collision_filter(spc.props.collision_filter), m_position(spc.position), m_body(body),
+      m_density(spc.props.density), m_charge_density(spc.props.charge_density),
+      m_surface(surface2D::resolve(spc.props.friction, spc.props.restitution)), m_material(spc.props.material),
+      m_type(spc.props.shape)
 {
     meta.index = world.colliders.size();
     transform2D transform{kit::transform2D<float>::builder().position(spc.position).rotation(spc.rotation).build()};
@@ -22,6 +23,7 @@ collider2D::collider2D(world2D &world, body2D *body, const specs &spc)
         m_shape = circle(transform, spc.props.radius);
         break;
     }
+    update_local_data();
     // Parent must be updated (happens outside)
 }
 
@@ -62,6 +64,40 @@ void collider2D::charge_density(float charge_density)
     m_charge_density = charge_density;
 }
 
+float collider2D::restitution() const
+{
+    return m_surface.restitution;
+}
+void collider2D::restitution(const float restitution)
+{
+    m_surface = surface2D::resolve(m_surface.friction, restitution);
+}
+
+float collider2D::friction() const
+{
+    return m_surface.friction;
+}
+void collider2D::friction(const float friction)
+{
+    m_surface = surface2D::resolve(friction, m_surface.restitution);
+}
+
+std::uint32_t collider2D::material() const
+{
+    return m_material;
+}
+void collider2D::material(const std::uint32_t material)
+{
+    KIT_ASSERT_WARN(world.collisions.materials.contains(material),
+                    "Material id {0} is not in the material table. It will behave as material 0", material)
+    m_material = material;
+}
+
+const surface2D &collider2D::surface() const
+{
+    return m_surface;
+}
+
 const transform2D &collider2D::ltransform() const
 {
     return call_shape_method_const([](const auto &shape) -> const transform2D & { return shape.ltransform(); });
@@ -71,6 +107,7 @@ void collider2D::ltransform(const transform2D &ltransform)
     const glm::vec2 &lpos = call_shape_method([](const auto &shape) -> const glm::vec2 & { return shape.lposition(); });
     m_position += lpos - ltransform.position;
     call_shape_method([&ltransform](auto &shape) { shape.ltransform(ltransform); });
+    update_local_data();
     m_body->full_update();
 }
 
@@ -98,6 +135,15 @@ float collider2D::inertia() const
 {
     return call_shape_method_const([](const auto &shape) -> float { return shape.inertia(); });
 }
+float collider2D::radius() const
+{
+    return m_radius;
+}
+
+const kit::dynarray<glm::vec2, PPX_MAX_VERTICES> &collider2D::lnormals() const
+{
+    return m_lnormals;
+}
 
 bool collider2D::is_circle() const
 {
@@ -124,6 +170,7 @@ void collider2D::gtranslate(const glm::vec2 &dpos)
 void collider2D::lrotate(float dangle)
 {
     call_shape_method([&dangle](auto &shape) { shape.lrotate(dangle); });
+    update_local_data();
     update_bounding_boxes();
 }
 
@@ -172,6 +219,7 @@ const glm::vec2 &collider2D::origin() const
 void collider2D::lrotation(float lrotation)
 {
     call_shape_method([&lrotation](auto &shape) { shape.lrotation(lrotation); });
+    update_local_data();
     update_bounding_boxes();
 }
 void collider2D::origin(const glm::vec2 &origin)
@@ -191,6 +239,35 @@ void collider2D::gtranslate_shape(const glm::vec2 &dpos)
     update_bounding_boxes();
 }
 
+void collider2D::update_local_data()
+{
+    m_lnormals.clear();
+    if (is_circle())
+    {
+        m_radius = shape<circle>().radius();
+        return;
+    }
+
+    const polygon &poly = shape<polygon>();
+    const auto &vertices = poly.vertices.model;
+    m_radius = poly.radius();
+
+    glm::vec2 center{0.f};
+    for (const glm::vec2 &v : vertices)
+        center += v;
+    center /= (float)vertices.size();
+
+    const glm::mat2 rot = kit::transform2D<float>::rotation_matrix(poly.lrotation());
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 edge = vertices[(i + 1) % vertices.size()] - vertices[i];
+        glm::vec2 normal = glm::normalize(glm::vec2(edge.y, -edge.x));
+        if (glm::dot(normal, vertices[i] - center) < 0.f)
+            normal = -normal;
+        m_lnormals.push_back(rot * normal);
+    }
+}
+
 void collider2D::update_bounding_boxes()
 {
     m_tight_bb = call_shape_method([](const auto &shape) -> geo::aabb2D { return shape.create_bounding_box(); });
@@ -11,6 +11,8 @@ namespace ppx
 collider2D *collider_manager2D::add(body2D *parent, const collider2D::specs &spc)
 {
     collider2D *collider = allocator<collider2D>::create(world, parent, spc);
+    KIT_ASSERT_ERROR(m_next_id != UINT32_MAX, "Ran out of collider ids")
+    collider->meta.id = m_next_id++;
     m_elements.push_back(collider);
 
     parent->m_colliders.push_back(collider);
@@ -36,8 +36,25 @@ void collision_manager2D::detect_and_create_contacts()
     if (m_narrow->enabled()) [[likely]]
         m_narrow->update_contacts(pairs, m_contacts.get());
 
-    if (m_contacts->enabled()) [[likely]]
-        m_contacts->remove_expired_contacts();
+    if (!m_contacts->enabled()) [[unlikely]]
+        return;
+    m_contacts->remove_expired_contacts();
+    if (pre_solve_filter)
+        m_contacts->apply_pre_solve_filter(pre_solve_filter);
+}
+
+void collision_manager2D::deliver_contact_events()
+{
+    if (!events.on_contact_events.has_subscribers()) [[likely]]
+    {
+        m_contacts->m_events.clear(); // ends owed to listeners that already left
+        return;
+    }
+    KIT_PERF_SCOPE("ppx::collision_manager2D::deliver_contact_events")
+    m_contacts->record_active_contacts();
+    if (!m_contacts->m_events.empty())
+        events.on_contact_events(std::span<const contact_event2D>(m_contacts->m_events));
+    m_contacts->m_events.clear();
 }
 
 void collision_manager2D::enabled(const bool enabled)
@@ -1,6 +1,7 @@
 #include "ppx/internal/pch.hpp"
 #include "ppx/collision/contacts/contact.hpp"
 #include "ppx/world.hpp"
+#include "kit/utility/utils.hpp"
 
 namespace ppx
 {
@@ -41,9 +42,16 @@ const geo::contact_point2D &contact2D::point() const
 {
     return m_point;
 }
+contact2D::contact_key contact2D::make_key(const collider2D *collider1, const collider2D *collider2,
+                                           const std::uint32_t feature)
+{
+    const std::uint64_t id1 = static_cast<std::uint64_t>(collider1->meta.id);
+    const std::uint64_t id2 = static_cast<std::uint64_t>(collider2->meta.id);
+    return {(id1 << 32) | id2, feature};
+}
 contact2D::contact_key contact2D::key() const
 {
-    return {m_collider1, m_collider2, m_point.id.key};
+    return make_key(m_collider1, m_collider2, m_point.id.key);
 }
 
 const glm::vec2 &contact2D::normal() const
@@ -59,30 +67,31 @@ float contact2D::friction() const
     return m_friction;
 }
 
-void contact2D::on_enter()
+float contact2D::normal_impulse() const
 {
-    m_collider1->events.on_contact_enter(this);
-    m_collider2->events.on_contact_enter(this);
-    world.collisions.events.on_contact_enter(this);
+    return glm::dot(reactive_force(), m_normal) * world.integrator.ts.value;
 }
-void contact2D::on_exit()
+float contact2D::tangent_impulse() const
 {
-    m_collider1->events.on_contact_exit(*this);
-    m_collider2->events.on_contact_exit(*this);
-    world.collisions.events.on_contact_exit(*this);
+    return kit::cross2D(m_normal, reactive_force()) * world.integrator.ts.value;
 }
 
-void contact2D::on_pre_solve()
+void contact2D::on_enter()
 {
-    m_collider1->events.on_contact_pre_solve(this);
-    m_collider2->events.on_contact_pre_solve(this);
-    world.collisions.events.on_contact_pre_solve(this);
+    m_just_entered = true;
 }
-void contact2D::on_post_solve()
+// contacts vetoed or lost before they were ever recorded end silently, so that every END has a BEGIN
+void contact2D::on_exit(const collider2D *removed)
 {
-    m_collider1->events.on_contact_post_solve(this);
-    m_collider2->events.on_contact_post_solve(this);
-    world.collisions.events.on_contact_post_solve(this);
+    m_just_entered = false;
+    if (!m_reported)
+        return;
+    m_reported = false;
+    world.collisions.contact_manager()->record_end(*this, removed);
+}
+bool contact2D::just_entered() const
+{
+    return m_just_entered;
 }
 
 bool contact2D::is_contact() const
@@ -110,5 +119,9 @@ std::uint32_t contact2D::life_expectancy() const
 {
     return world.collisions.contact_manager()->params.contact_lifetime - m_age;
 }
+std::uint32_t contact2D::age() const
+{
+    return m_age;
+}
 
 } // namespace ppx
\ No newline at end of file
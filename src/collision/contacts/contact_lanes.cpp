@@ -0,0 +1,152 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/collision/contacts/contact_lanes.hpp"
+
+#if defined(PPX_SIMD_X86)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(PPX_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "ppx/collision/contacts/contact_lanes_impl.hpp"
+
+namespace ppx
+{
+namespace
+{
+#if defined(PPX_SIMD_X86)
+// SSE2 is part of the x86-64 baseline, so this kernel is always available there
+struct sse_float4
+{
+    static inline constexpr std::size_t WIDTH = 4;
+    __m128 v;
+
+    static sse_float4 load(const float *ptr)
+    {
+        return {_mm_load_ps(ptr)};
+    }
+    static void store(float *ptr, const sse_float4 &x)
+    {
+        _mm_store_ps(ptr, x.v);
+    }
+    static sse_float4 broadcast(const float x)
+    {
+        return {_mm_set1_ps(x)};
+    }
+    static sse_float4 min(const sse_float4 &a, const sse_float4 &b)
+    {
+        return {_mm_min_ps(a.v, b.v)};
+    }
+    static sse_float4 max(const sse_float4 &a, const sse_float4 &b)
+    {
+        return {_mm_max_ps(a.v, b.v)};
+    }
+};
+
+sse_float4 operator+(const sse_float4 &a, const sse_float4 &b)
+{
+    return {_mm_add_ps(a.v, b.v)};
+}
+sse_float4 operator-(const sse_float4 &a, const sse_float4 &b)
+{
+    return {_mm_sub_ps(a.v, b.v)};
+}
+sse_float4 operator*(const sse_float4 &a, const sse_float4 &b)
+{
+    return {_mm_mul_ps(a.v, b.v)};
+}
+
+void solve_contact_lanes_sse(contact_lanes2D &lanes)
+{
+    solve_contact_lanes<sse_float4>(lanes);
+}
+
+bool cpu_supports_avx2()
+{
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    const bool osxsave = regs[2] & (1 << 27);
+    const bool avx = regs[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return regs[1] & (1 << 5);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#elif defined(PPX_SIMD_NEON)
+struct neon_float4
+{
+    static inline constexpr std::size_t WIDTH = 4;
+    float32x4_t v;
+
+    static neon_float4 load(const float *ptr)
+    {
+        return {vld1q_f32(ptr)};
+    }
+    static void store(float *ptr, const neon_float4 &x)
+    {
+        vst1q_f32(ptr, x.v);
+    }
+    static neon_float4 broadcast(const float x)
+    {
+        return {vdupq_n_f32(x)};
+    }
+    static neon_float4 min(const neon_float4 &a, const neon_float4 &b)
+    {
+        return {vminq_f32(a.v, b.v)};
+    }
+    static neon_float4 max(const neon_float4 &a, const neon_float4 &b)
+    {
+        return {vmaxq_f32(a.v, b.v)};
+    }
+};
+
+neon_float4 operator+(const neon_float4 &a, const neon_float4 &b)
+{
+    return {vaddq_f32(a.v, b.v)};
+}
+neon_float4 operator-(const neon_float4 &a, const neon_float4 &b)
+{
+    return {vsubq_f32(a.v, b.v)};
+}
+neon_float4 operator*(const neon_float4 &a, const neon_float4 &b)
+{
+    return {vmulq_f32(a.v, b.v)};
+}
+
+void solve_contact_lanes_neon(contact_lanes2D &lanes)
+{
+    solve_contact_lanes<neon_float4>(lanes);
+}
+#endif
+
+contact_lanes_kernel2D select_kernel()
+{
+#if defined(PPX_SIMD_X86)
+    if (cpu_supports_avx2())
+        return {solve_contact_lanes_avx2, 8, "AVX2"};
+    return {solve_contact_lanes_sse, 4, "SSE2"};
+#elif defined(PPX_SIMD_NEON)
+    return {solve_contact_lanes_neon, 4, "NEON"};
+#else
+    return {};
+#endif
+}
+} // namespace
+
+const contact_lanes_kernel2D &contact_lanes_kernel()
+{
+    static const contact_lanes_kernel2D kernel = select_kernel();
+    return kernel;
+}
+} // namespace ppx
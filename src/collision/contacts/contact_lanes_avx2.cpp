@@ -0,0 +1,74 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/collision/contacts/contact_lanes.hpp"
+
+#ifdef PPX_SIMD_X86
+#include <immintrin.h>
+
+// the rest of the library is built for the baseline ISA, so only the code below is allowed to emit AVX2. The kernel
+// header must be included inside the region for its template to be compiled with the same target
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "ppx/collision/contacts/contact_lanes_impl.hpp"
+
+namespace ppx
+{
+namespace
+{
+struct avx_float8
+{
+    static inline constexpr std::size_t WIDTH = 8;
+    __m256 v;
+
+    static avx_float8 load(const float *ptr)
+    {
+        return {_mm256_load_ps(ptr)};
+    }
+    static void store(float *ptr, const avx_float8 &x)
+    {
+        _mm256_store_ps(ptr, x.v);
+    }
+    static avx_float8 broadcast(const float x)
+    {
+        return {_mm256_set1_ps(x)};
+    }
+    static avx_float8 min(const avx_float8 &a, const avx_float8 &b)
+    {
+        return {_mm256_min_ps(a.v, b.v)};
+    }
+    static avx_float8 max(const avx_float8 &a, const avx_float8 &b)
+    {
+        return {_mm256_max_ps(a.v, b.v)};
+    }
+};
+
+avx_float8 operator+(const avx_float8 &a, const avx_float8 &b)
+{
+    return {_mm256_add_ps(a.v, b.v)};
+}
+avx_float8 operator-(const avx_float8 &a, const avx_float8 &b)
+{
+    return {_mm256_sub_ps(a.v, b.v)};
+}
+avx_float8 operator*(const avx_float8 &a, const avx_float8 &b)
+{
+    return {_mm256_mul_ps(a.v, b.v)};
+}
+} // namespace
+
+void solve_contact_lanes_avx2(contact_lanes2D &lanes)
+{
+    solve_contact_lanes<avx_float8>(lanes);
+}
+} // namespace ppx
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+#endif
@@ -0,0 +1,479 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/collision/contacts/contact_solver.hpp"
+#include "ppx/world.hpp"
+#include "kit/utility/utils.hpp"
+
+namespace ppx
+{
+void contact_solver2D::startup(std::vector<state2D> &states)
+{
+    m_states = &states;
+    m_contacts.clear();
+
+    m_index1.clear();
+    m_index2.clear();
+    m_flags.clear();
+
+    m_imass1.clear();
+    m_imass2.clear();
+    m_iinertia1.clear();
+    m_iinertia2.clear();
+
+    m_normal.clear();
+    m_offset1.clear();
+    m_offset2.clear();
+
+    m_normal_mass.clear();
+    m_tangent_mass.clear();
+    m_bias.clear();
+    m_relax_bias.clear();
+    m_mass_scale.clear();
+    m_impulse_scale.clear();
+    m_friction.clear();
+
+    m_normal_impulse.clear();
+    m_tangent_impulse.clear();
+
+    m_block_k.clear();
+    m_block_mass.clear();
+    m_block_row2.clear();
+    m_units.clear();
+    m_open_pairs.clear();
+    m_use_bias = true;
+}
+
+void contact_solver2D::add(nonpen_contact2D *contact)
+{
+    KIT_ASSERT_ERROR(m_states == contact->m_states, "Contact was started up with a different state array")
+    m_inv_ts = 1.f / contact->m_ts;
+    m_contacts.push_back(contact);
+
+    m_index1.push_back(contact->m_index1);
+    m_index2.push_back(contact->m_index2);
+
+    std::uint8_t flags = 0;
+    if (contact->m_dyn1)
+        flags |= DYNAMIC1;
+    if (contact->m_dyn2)
+        flags |= DYNAMIC2;
+    if (contact->m_has_friction)
+        flags |= FRICTION;
+    m_flags.push_back(flags);
+
+    m_imass1.push_back(contact->m_imass1);
+    m_imass2.push_back(contact->m_imass2);
+    m_iinertia1.push_back(contact->m_iinertia1);
+    m_iinertia2.push_back(contact->m_iinertia2);
+
+    m_normal.push_back(contact->m_dir);
+    m_offset1.push_back(contact->m_offset1);
+    m_offset2.push_back(contact->m_offset2);
+
+    const specs::joint_manager2D::constraints2D &params = contact->world.joints.constraints.params;
+    m_soft = params.soft_step;
+    if (m_soft)
+        add_soft_row(contact, params.max_contact_push_velocity);
+    else
+    {
+        // everything in the constraint velocity that does not depend on the current body velocities
+        float bias = contact->m_speculative ? contact->m_point.penetration * m_inv_ts
+                                            : contact->m_restitution * contact->m_init_ctr_vel;
+        if (contact->m_baumgarte && glm::abs(contact->m_c) > contact->m_bthreshold)
+            bias += contact->m_bcoeff * contact->m_c * m_inv_ts;
+
+        m_normal_mass.push_back(contact->m_mass);
+        m_bias.push_back(bias);
+        m_relax_bias.push_back(bias);
+        m_mass_scale.push_back(1.f);
+        m_impulse_scale.push_back(0.f);
+    }
+    m_tangent_mass.push_back(contact->m_friction_contact.m_mass);
+    m_friction.push_back(contact->m_friction);
+
+    m_normal_impulse.push_back(contact->m_cumimpulse);
+    m_tangent_impulse.push_back(contact->m_friction_contact.m_cumimpulse);
+    if (m_soft || !try_pair(m_contacts.size() - 1))
+        m_units.push_back({m_contacts.size() - 1, NO_BLOCK});
+}
+
+// the separation is tracked through the anchors, which are recomputed from the current positions every substep. the
+// spring is capped at a quarter of the substep rate to stay stable
+void contact_solver2D::add_soft_row(const nonpen_contact2D *contact, const float max_push)
+{
+    const float restitution_bias = contact->m_speculative ? 0.f : contact->m_restitution * contact->m_init_ctr_vel;
+    const float separation =
+        contact->m_point.penetration + glm::dot(contact->m_dir, contact->m_ganchor2 - contact->m_ganchor1);
+
+    m_normal_mass.push_back(1.f / contact->default_inverse_mass());
+    m_relax_bias.push_back(restitution_bias + std::max(separation, 0.f) * m_inv_ts);
+
+    const float hertz = std::min(contact->m_frequency, 0.25f * m_inv_ts);
+    const float omega = 2.f * glm::pi<float>() * hertz;
+    const float a1 = 2.f * contact->m_damping_ratio + omega / m_inv_ts;
+    if (separation > 0.f || kit::approaches_zero(omega) || kit::approaches_zero(a1))
+    {
+        m_bias.push_back(m_relax_bias.back());
+        m_mass_scale.push_back(1.f);
+        m_impulse_scale.push_back(0.f);
+        return;
+    }
+
+    const float a2 = omega * a1 / m_inv_ts;
+    const float a3 = 1.f / (1.f + a2);
+    m_bias.push_back(restitution_bias + std::max(omega * separation / a1, -max_push));
+    m_mass_scale.push_back(a2 * a3);
+    m_impulse_scale.push_back(a3);
+}
+
+// the points of a manifold share their collider pair, but removals and reorders may have moved them apart, so rows
+// are matched through the pair instead of their position. a pair holds a single manifold of at most two points
+bool contact_solver2D::try_pair(const std::size_t row2)
+{
+    const auto [it, inserted] = m_open_pairs.try_emplace(m_contacts[row2]->key().colliders, m_units.size());
+    if (inserted)
+        return false;
+    const std::size_t unit = it->second;
+    m_open_pairs.erase(it);
+
+    const std::size_t row1 = m_units[unit].row;
+    const nonpen_contact2D *contact1 = m_contacts[row1];
+    const nonpen_contact2D *contact2 = m_contacts[row2];
+    if (contact1->collider1() != contact2->collider1() || contact1->collider2() != contact2->collider2() ||
+        m_flags[row1] != m_flags[row2] || glm::dot(m_normal[row1], m_normal[row2]) < 0.999f)
+        return false;
+
+    const glm::vec2 &normal = m_normal[row1];
+    const float rn11 = kit::cross2D(m_offset1[row1], normal);
+    const float rn12 = kit::cross2D(m_offset1[row2], normal);
+    const float rn21 = kit::cross2D(m_offset2[row1], normal);
+    const float rn22 = kit::cross2D(m_offset2[row2], normal);
+
+    float k12 = 0.f;
+    if (m_flags[row1] & DYNAMIC1)
+        k12 += m_imass1[row1] + m_iinertia1[row1] * rn11 * rn12;
+    if (m_flags[row1] & DYNAMIC2)
+        k12 += m_imass2[row1] + m_iinertia2[row1] * rn21 * rn22;
+
+    // the diagonal is taken from the row masses so that both paths agree on a single point
+    const float k11 = 1.f / m_normal_mass[row1];
+    const float k22 = 1.f / m_normal_mass[row2];
+    const float det = k11 * k22 - k12 * k12;
+    if (k11 * k11 >= MAX_BLOCK_CONDITION * det)
+        return false;
+
+    const glm::mat2 k{k11, k12, k12, k22};
+    m_units[unit].block = m_block_k.size();
+    m_block_k.push_back(k);
+    m_block_mass.push_back(glm::inverse(k));
+    m_block_row2.push_back(row2);
+    return true;
+}
+
+void contact_solver2D::apply_impulse(const std::size_t row, const glm::vec2 &impulse, state2D &state1,
+                                     state2D &state2) const
+{
+    const glm::vec2 force = impulse * m_inv_ts;
+    const std::uint8_t flags = m_flags[row];
+    if (flags & DYNAMIC1)
+    {
+        const float dw1 = kit::cross2D(m_offset1[row], impulse);
+        state1.velocity -= m_imass1[row] * impulse;
+        state1.angular_velocity -= m_iinertia1[row] * dw1;
+        state1.substep_force -= force;
+        state1.substep_torque -= dw1 * m_inv_ts;
+    }
+    if (flags & DYNAMIC2)
+    {
+        const float dw2 = kit::cross2D(m_offset2[row], impulse);
+        state2.velocity += m_imass2[row] * impulse;
+        state2.angular_velocity += m_iinertia2[row] * dw2;
+        state2.substep_force += force;
+        state2.substep_torque += dw2 * m_inv_ts;
+    }
+}
+
+float contact_solver2D::solve_friction(const std::size_t row, state2D &state1, state2D &state2)
+{
+    const glm::vec2 &normal = m_normal[row];
+    const glm::vec2 tangent{-normal.y, normal.x};
+    const float cvel = glm::dot(tangent, state2.velocity_at_centroid_offset(m_offset2[row]) -
+                                             state1.velocity_at_centroid_offset(m_offset1[row]));
+    const float max_impulse = m_friction[row] * m_normal_impulse[row];
+    const float old_impulse = m_tangent_impulse[row];
+    m_tangent_impulse[row] = std::clamp(old_impulse - cvel * m_tangent_mass[row], -max_impulse, max_impulse);
+
+    const float delta = m_tangent_impulse[row] - old_impulse;
+    apply_impulse(row, delta * tangent, state1, state2);
+    return glm::abs(delta);
+}
+
+float contact_solver2D::solve_normal(const std::size_t row, state2D &state1, state2D &state2)
+{
+    const glm::vec2 &normal = m_normal[row];
+    const float bias = m_use_bias ? m_bias[row] : m_relax_bias[row];
+    const float mass_scale = m_use_bias ? m_mass_scale[row] : 1.f;
+    const float impulse_scale = m_use_bias ? m_impulse_scale[row] : 0.f;
+
+    const float cvel = bias + glm::dot(normal, state2.velocity_at_centroid_offset(m_offset2[row]) -
+                                                   state1.velocity_at_centroid_offset(m_offset1[row]));
+    const float old_impulse = m_normal_impulse[row];
+    m_normal_impulse[row] =
+        std::max(old_impulse - cvel * m_normal_mass[row] * mass_scale - impulse_scale * old_impulse, 0.f);
+
+    const float delta = m_normal_impulse[row] - old_impulse;
+    apply_impulse(row, delta * normal, state1, state2);
+    return glm::abs(delta);
+}
+
+// finds x >= 0 such that K * x + b >= 0 and x_i * (K * x + b)_i = 0, enumerating the four possible active sets. b is
+// the constraint velocity with the current accumulated impulses removed (b = vn + bias - K * a)
+float contact_solver2D::solve_block(const std::size_t row, const std::size_t block, state2D &state1, state2D &state2)
+{
+    const std::size_t row1 = row;
+    const std::size_t row2 = m_block_row2[block];
+    const glm::vec2 &normal = m_normal[row1];
+    const glm::mat2 &k = m_block_k[block];
+
+    const glm::vec2 old_impulse{m_normal_impulse[row1], m_normal_impulse[row2]};
+    const glm::vec2 cvel{m_bias[row1] + glm::dot(normal, state2.velocity_at_centroid_offset(m_offset2[row1]) -
+                                                             state1.velocity_at_centroid_offset(m_offset1[row1])),
+                         m_bias[row2] + glm::dot(normal, state2.velocity_at_centroid_offset(m_offset2[row2]) -
+                                                             state1.velocity_at_centroid_offset(m_offset1[row2]))};
+    const glm::vec2 b = cvel - k * old_impulse;
+
+    // both points active
+    glm::vec2 impulse = -(m_block_mass[block] * b);
+    if (impulse.x < 0.f || impulse.y < 0.f)
+    {
+        // only the first point active
+        impulse = {-b.x / k[0][0], 0.f};
+        if (impulse.x < 0.f || k[0][1] * impulse.x + b.y < 0.f)
+        {
+            // only the second point active
+            impulse = {0.f, -b.y / k[1][1]};
+            if (impulse.y < 0.f || k[1][0] * impulse.y + b.x < 0.f)
+            {
+                // both points separating
+                impulse = glm::vec2{0.f};
+                if (b.x < 0.f || b.y < 0.f) [[unlikely]]
+                {
+                    const float delta1 = solve_normal(row1, state1, state2);
+                    const float delta2 = solve_normal(row2, state1, state2);
+                    return std::max(delta1, delta2);
+                }
+            }
+        }
+    }
+
+    const glm::vec2 delta = impulse - old_impulse;
+    m_normal_impulse[row1] = impulse.x;
+    m_normal_impulse[row2] = impulse.y;
+    apply_impulse(row1, delta.x * normal, state1, state2);
+    apply_impulse(row2, delta.y * normal, state1, state2);
+    return std::max(glm::abs(delta.x), glm::abs(delta.y));
+}
+
+float contact_solver2D::solve_unit(const std::size_t unit)
+{
+    std::vector<state2D> &states = *m_states;
+    const auto [row, block] = m_units[unit];
+    state2D &st1 = states[m_index1[row]];
+    state2D &st2 = states[m_index2[row]];
+    if (block != NO_BLOCK)
+    {
+        float delta = 0.f;
+        if (m_flags[row] & FRICTION)
+        {
+            delta = solve_friction(row, st1, st2);
+            delta = std::max(delta, solve_friction(m_block_row2[block], st1, st2));
+        }
+        return std::max(delta, solve_block(row, block, st1, st2));
+    }
+
+    const float delta = (m_flags[row] & FRICTION) ? solve_friction(row, st1, st2) : 0.f;
+    return std::max(delta, solve_normal(row, st1, st2));
+}
+
+void contact_solver2D::gather_lane(contact_lanes2D &lanes, const std::size_t lane, const std::size_t row) const
+{
+    const std::vector<state2D> &states = *m_states;
+    const state2D &st1 = states[m_index1[row]];
+    const state2D &st2 = states[m_index2[row]];
+    const std::uint8_t flags = m_flags[row];
+    const bool dyn1 = flags & DYNAMIC1;
+    const bool dyn2 = flags & DYNAMIC2;
+
+    lanes.v1x[lane] = st1.velocity.x;
+    lanes.v1y[lane] = st1.velocity.y;
+    lanes.w1[lane] = st1.angular_velocity;
+    lanes.v2x[lane] = st2.velocity.x;
+    lanes.v2y[lane] = st2.velocity.y;
+    lanes.w2[lane] = st2.angular_velocity;
+
+    lanes.nx[lane] = m_normal[row].x;
+    lanes.ny[lane] = m_normal[row].y;
+    lanes.r1x[lane] = m_offset1[row].x;
+    lanes.r1y[lane] = m_offset1[row].y;
+    lanes.r2x[lane] = m_offset2[row].x;
+    lanes.r2y[lane] = m_offset2[row].y;
+
+    // zeroed masses stand in for the dynamic checks of the scalar path
+    lanes.imass1[lane] = dyn1 ? m_imass1[row] : 0.f;
+    lanes.imass2[lane] = dyn2 ? m_imass2[row] : 0.f;
+    lanes.iinertia1[lane] = dyn1 ? m_iinertia1[row] : 0.f;
+    lanes.iinertia2[lane] = dyn2 ? m_iinertia2[row] : 0.f;
+
+    lanes.normal_mass[lane] = m_normal_mass[row];
+    lanes.tangent_mass[lane] = (flags & FRICTION) ? m_tangent_mass[row] : 0.f;
+    lanes.bias[lane] = m_use_bias ? m_bias[row] : m_relax_bias[row];
+    lanes.mass_scale[lane] = m_use_bias ? m_mass_scale[row] : 1.f;
+    lanes.impulse_scale[lane] = m_use_bias ? m_impulse_scale[row] : 0.f;
+    lanes.friction[lane] = (flags & FRICTION) ? m_friction[row] : 0.f;
+
+    lanes.normal_impulse[lane] = m_normal_impulse[row];
+    lanes.tangent_impulse[lane] = m_tangent_impulse[row];
+}
+
+float contact_solver2D::scatter_lane(const contact_lanes2D &lanes, const std::size_t lane, const std::size_t row)
+{
+    std::vector<state2D> &states = *m_states;
+    const float delta = std::max(glm::abs(lanes.normal_impulse[lane] - m_normal_impulse[row]),
+                                 glm::abs(lanes.tangent_impulse[lane] - m_tangent_impulse[row]));
+    m_normal_impulse[row] = lanes.normal_impulse[lane];
+    m_tangent_impulse[row] = lanes.tangent_impulse[lane];
+
+    const glm::vec2 impulse{lanes.px[lane], lanes.py[lane]};
+    const glm::vec2 force = impulse * m_inv_ts;
+    const std::uint8_t flags = m_flags[row];
+    if (flags & DYNAMIC1)
+    {
+        state2D &st1 = states[m_index1[row]];
+        st1.velocity = {lanes.v1x[lane], lanes.v1y[lane]};
+        st1.angular_velocity = lanes.w1[lane];
+        st1.substep_force -= force;
+        st1.substep_torque -= kit::cross2D(m_offset1[row], impulse) * m_inv_ts;
+    }
+    if (flags & DYNAMIC2)
+    {
+        state2D &st2 = states[m_index2[row]];
+        st2.velocity = {lanes.v2x[lane], lanes.v2y[lane]};
+        st2.angular_velocity = lanes.w2[lane];
+        st2.substep_force += force;
+        st2.substep_torque += kit::cross2D(m_offset2[row], impulse) * m_inv_ts;
+    }
+    return delta;
+}
+
+float contact_solver2D::solve_lanes(const contact_lanes_kernel2D &kernel, const std::size_t *rows)
+{
+    contact_lanes2D lanes;
+    for (std::size_t i = 0; i < kernel.width; i++)
+        gather_lane(lanes, i, rows[i]);
+    kernel.solve(lanes);
+
+    float delta = 0.f;
+    for (std::size_t i = 0; i < kernel.width; i++)
+        delta = std::max(delta, scatter_lane(lanes, i, rows[i]));
+    return delta;
+}
+
+float contact_solver2D::solve_units(const std::size_t *units, const std::size_t count)
+{
+    const contact_lanes_kernel2D &kernel = contact_lanes_kernel();
+    float delta = 0.f;
+    if (kernel.width == 0)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            delta = std::max(delta, solve_unit(units[i]));
+        return delta;
+    }
+
+    // blocks keep the scalar path, as does the tail that does not fill a whole group
+    std::size_t rows[contact_lanes2D::MAX_WIDTH];
+    std::size_t pending[contact_lanes2D::MAX_WIDTH];
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const row_unit &unit = m_units[units[i]];
+        if (unit.block != NO_BLOCK)
+        {
+            delta = std::max(delta, solve_unit(units[i]));
+            continue;
+        }
+        pending[size] = units[i];
+        rows[size++] = unit.row;
+        if (size == kernel.width)
+        {
+            delta = std::max(delta, solve_lanes(kernel, rows));
+            size = 0;
+        }
+    }
+    for (std::size_t i = 0; i < size; i++)
+        delta = std::max(delta, solve_unit(pending[i]));
+    return delta;
+}
+
+float contact_solver2D::solve_velocities()
+{
+    float delta = 0.f;
+    for (std::size_t i = 0; i < m_units.size(); i++)
+        delta = std::max(delta, solve_unit(i));
+    return delta;
+}
+
+void contact_solver2D::use_bias(const bool use_bias)
+{
+    m_use_bias = use_bias;
+}
+
+void contact_solver2D::store_impulses() const
+{
+    for (std::size_t i = 0; i < m_contacts.size(); i++)
+    {
+        m_contacts[i]->m_cumimpulse = m_normal_impulse[i];
+        m_contacts[i]->m_friction_contact.m_cumimpulse = m_tangent_impulse[i];
+    }
+}
+
+const std::vector<nonpen_contact2D *> &contact_solver2D::contacts() const
+{
+    return m_contacts;
+}
+std::size_t contact_solver2D::size() const
+{
+    return m_contacts.size();
+}
+float contact_solver2D::largest_impulse() const
+{
+    float largest = 0.f;
+    for (std::size_t i = 0; i < m_normal_impulse.size(); i++)
+        largest = std::max({largest, glm::abs(m_normal_impulse[i]), glm::abs(m_tangent_impulse[i])});
+    return largest;
+}
+
+bool contact_solver2D::empty() const
+{
+    return m_contacts.empty();
+}
+
+std::size_t contact_solver2D::unit_count() const
+{
+    return m_units.size();
+}
+std::size_t contact_solver2D::unit_index1(const std::size_t unit) const
+{
+    return m_index1[m_units[unit].row];
+}
+std::size_t contact_solver2D::unit_index2(const std::size_t unit) const
+{
+    return m_index2[m_units[unit].row];
+}
+bool contact_solver2D::unit_dynamic1(const std::size_t unit) const
+{
+    return m_flags[m_units[unit].row] & DYNAMIC1;
+}
+bool contact_solver2D::unit_dynamic2(const std::size_t unit) const
+{
+    return m_flags[m_units[unit].row] & DYNAMIC2;
+}
+} // namespace ppx
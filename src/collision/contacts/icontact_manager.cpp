@@ -7,6 +7,7 @@ namespace ppx
 void icontact_manager2D::inherit(icontact_manager2D &&contacts)
 {
     params = contacts.params;
+    m_events = std::move(contacts.m_events);
 }
 
 void icontact_manager2D::enabled(const bool enabled)
@@ -16,6 +17,24 @@ void icontact_manager2D::enabled(const bool enabled)
         destroy_all_contacts();
 }
 
+void icontact_manager2D::record(contact2D *contact)
+{
+    const auto type = contact->m_just_entered ? contact_event2D::etype::BEGIN : contact_event2D::etype::PERSIST;
+    contact->m_just_entered = false;
+    contact->m_reported = true;
+    m_events.push_back({type, contact->collider1(), contact->collider2(), contact->point().id.key,
+                        contact->point().point, contact->normal(), contact->normal_impulse(),
+                        contact->tangent_impulse()});
+}
+
+void icontact_manager2D::record_end(const contact2D &contact, const collider2D *removed)
+{
+    collider2D *collider1 = contact.collider1() == removed ? nullptr : contact.collider1();
+    collider2D *collider2 = contact.collider2() == removed ? nullptr : contact.collider2();
+    m_events.push_back({contact_event2D::etype::END, collider1, collider2, contact.point().id.key,
+                        contact.point().point, contact.normal(), contact.normal_impulse(), contact.tangent_impulse()});
+}
+
 bool icontact_manager2D::checksum(const body_manager2D &bm) const
 {
     std::unordered_set<const contact2D *> body_contacts;
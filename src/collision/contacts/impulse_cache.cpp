@@ -0,0 +1,83 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/collision/contacts/impulse_cache.hpp"
+
+namespace ppx
+{
+static std::uint32_t closest_point(const std::array<impulse_cache2D::point, 2> &points, const std::uint32_t count,
+                                   const glm::vec2 &lanchor1, const float match_distance)
+{
+    std::uint32_t closest = count;
+    float min_dist = match_distance * match_distance;
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        const glm::vec2 diff = points[i].lanchor1 - lanchor1;
+        const float dist = glm::dot(diff, diff);
+        if (dist <= min_dist)
+        {
+            min_dist = dist;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+void impulse_cache2D::store(const std::uint64_t pair, const point &pt, const std::uint32_t step,
+                            const float match_distance)
+{
+    entry &e = m_entries[pair];
+    if (step - e.step > LIFETIME)
+        e.count = 0;
+    e.step = step;
+
+    const std::uint32_t closest = closest_point(e.points, e.count, pt.lanchor1, match_distance);
+    if (closest < e.count)
+        e.points[closest] = pt;
+    else if (e.count < e.points.size())
+        e.points[e.count++] = pt;
+    else // both slots hold points far from this one
+        e.points[0] = pt;
+}
+
+bool impulse_cache2D::take(const std::uint64_t pair, const glm::vec2 &lanchor1, const std::uint32_t step,
+                           const float match_distance, point &pt)
+{
+    const auto it = m_entries.find(pair);
+    if (it == m_entries.end())
+        return false;
+
+    entry &e = it->second;
+    if (step - e.step > LIFETIME)
+    {
+        m_entries.erase(it);
+        return false;
+    }
+
+    const std::uint32_t closest = closest_point(e.points, e.count, lanchor1, match_distance);
+    if (closest == e.count)
+        return false;
+
+    pt = e.points[closest];
+    e.points[closest] = e.points[--e.count];
+    if (e.count == 0)
+        m_entries.erase(it);
+    return true;
+}
+
+void impulse_cache2D::purge(const std::uint32_t step)
+{
+    std::erase_if(m_entries, [step](const auto &pair) { return step - pair.second.step > LIFETIME; });
+}
+void impulse_cache2D::clear()
+{
+    m_entries.clear();
+}
+
+std::size_t impulse_cache2D::size() const
+{
+    return m_entries.size();
+}
+bool impulse_cache2D::empty() const
+{
+    return m_entries.empty();
+}
+} // namespace ppx
@@ -9,26 +9,39 @@ nonpen_contact2D::nonpen_contact2D(world2D &world, const collision2D *collision,
     : joint2D(world, collision->collider1->body(), collision->collider2->body(),
               collision->manifold[manifold_index].point),
       contact2D(collision, manifold_index), m_friction_contact(world, collision, m_normal, manifold_index),
-      m_has_friction(!kit::approaches_zero(collision->friction))
+      m_has_friction(!kit::approaches_zero(collision->friction)), m_speculative(m_point.penetration > 0.f)
 {
     m_ganchor1 = collision->manifold[manifold_index].point;
-    if (!kit::approaches_zero(m_restitution))
-    {
-        m_init_ctr_vel =
-            glm::dot(m_normal, m_body2->state().gvelocity_at(m_ganchor1) - m_body1->state().gvelocity_at(m_ganchor1));
-        if (glm::abs(m_init_ctr_vel) < 6.f)
-            m_init_ctr_vel = 0.f;
-    }
+    if (m_speculative)
+        m_approach_vel = normal_velocity(m_ganchor1);
+    else if (!kit::approaches_zero(m_restitution))
+        restitution_velocity(normal_velocity(m_ganchor1));
+}
+
+float nonpen_contact2D::normal_velocity(const glm::vec2 &point) const
+{
+    return glm::dot(m_normal, m_body2->state().gvelocity_at(point) - m_body1->state().gvelocity_at(point));
+}
+void nonpen_contact2D::restitution_velocity(const float velocity)
+{
+    m_init_ctr_vel = glm::abs(velocity) < 6.f ? 0.f : velocity;
 }
 
 float nonpen_contact2D::constraint_position() const
 {
+    // speculative points are not touching yet, so there is nothing to correct
+    if (m_speculative)
+        return 0.f;
     return m_point.penetration + m_pntr_correction;
 }
 float nonpen_contact2D::constraint_velocity() const
 {
-    return m_restitution * m_init_ctr_vel + glm::dot(m_dir, state2().velocity_at_centroid_offset(m_offset2) -
-                                                                state1().velocity_at_centroid_offset(m_offset1));
+    const float cvel = glm::dot(m_dir, state2().velocity_at_centroid_offset(m_offset2) -
+                                           state1().velocity_at_centroid_offset(m_offset1));
+    // the gap may close within the step, but no faster than that: no bounce, no tunneling
+    if (m_speculative)
+        return cvel + m_point.penetration / m_ts;
+    return m_restitution * m_init_ctr_vel + cvel;
 }
 
 void nonpen_contact2D::solve_velocities()
@@ -75,12 +88,50 @@ void nonpen_contact2D::update(const collision2D *collision, const std::size_t ma
     m_is_adjusting_positions = false;
     m_pntr_correction = 0.f;
     m_has_friction = !kit::approaches_zero(collision->friction);
+    m_speculative = m_point.penetration > 0.f;
+    if (m_speculative)
+    {
+        m_init_ctr_vel = 0.f;
+        m_approach_vel = normal_velocity(collision->manifold[manifold_index].point);
+    }
 
     m_is_soft = global_props.is_soft;
     m_frequency = global_props.frequency;
     m_damping_ratio = global_props.damping_ratio;
 }
 
+bool nonpen_contact2D::speculative() const
+{
+    return m_speculative;
+}
+
+float nonpen_contact2D::normal_impulse() const
+{
+    return m_cumimpulse;
+}
+float nonpen_contact2D::tangent_impulse() const
+{
+    return m_has_friction ? m_friction_contact.m_cumimpulse : 0.f;
+}
+
+void nonpen_contact2D::inherit_impulses(const float normal_impulse, const float tangent_impulse)
+{
+    m_cumimpulse = normal_impulse;
+    if (m_has_friction)
+        m_friction_contact.m_cumimpulse = std::clamp(tangent_impulse, -m_friction * normal_impulse,
+                                                     m_friction * normal_impulse);
+}
+
+float nonpen_contact2D::approach_velocity() const
+{
+    return m_approach_vel;
+}
+void nonpen_contact2D::inherit_approach_velocity(const float velocity)
+{
+    if (!m_speculative && !kit::approaches_zero(m_restitution))
+        restitution_velocity(std::min(m_init_ctr_vel, velocity));
+}
+
 glm::vec2 nonpen_contact2D::direction() const
 {
     return m_normal;
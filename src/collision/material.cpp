@@ -0,0 +1,153 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/collision/material.hpp"
+
+namespace ppx
+{
+static float combine_values(const float value1, const float value2, const float root1, const float root2,
+                            const material2D::combine_mode mode1, const material2D::combine_mode mode2)
+{
+    switch (std::max(mode1, mode2))
+    {
+    case material2D::combine_mode::GEOMETRIC_MEAN:
+        return root1 * root2;
+    case material2D::combine_mode::AVERAGE:
+        return 0.5f * (value1 + value2);
+    case material2D::combine_mode::MIN:
+        return std::min(value1, value2);
+    case material2D::combine_mode::MULTIPLY:
+        return value1 * value2;
+    case material2D::combine_mode::MAX:
+        return std::max(value1, value2);
+    }
+    return 0.f;
+}
+
+surface2D surface2D::resolve(const float friction, const float restitution)
+{
+    KIT_ASSERT_ERROR(friction >= 0.f, "Friction must be non-negative: {0}", friction)
+    KIT_ASSERT_ERROR(restitution >= 0.f, "Restitution must be non-negative: {0}", restitution)
+    return {friction, restitution, glm::sqrt(friction), glm::sqrt(restitution)};
+}
+
+material_table2D::material_table2D()
+{
+    clear();
+}
+
+material_table2D::material_id material_table2D::add(const material2D &material)
+{
+    KIT_ASSERT_ERROR(material.friction >= 0.f, "Friction must be non-negative: {0}", material.friction)
+    KIT_ASSERT_ERROR(material.restitution >= 0.f, "Restitution must be non-negative: {0}", material.restitution)
+    m_materials.push_back(material);
+    rebuild();
+    return (material_id)(m_materials.size() - 1);
+}
+
+void material_table2D::set(const material_id id, const material2D &material)
+{
+    KIT_ASSERT_ERROR(id != 0, "Material 0 is reserved and cannot be modified")
+    KIT_ASSERT_ERROR(id < m_materials.size(), "Material id out of bounds: {0}", id)
+    m_materials[id] = material;
+    rebuild();
+}
+
+void material_table2D::override_pair(const material_id id1, const material_id id2, const pair_properties &props)
+{
+    KIT_ASSERT_ERROR(id1 != 0 && id2 != 0, "Material 0 is reserved and cannot be paired")
+    KIT_ASSERT_ERROR(id1 < m_materials.size() && id2 < m_materials.size(), "Material id out of bounds")
+    for (pair_override &ovr : m_overrides)
+        if ((ovr.id1 == id1 && ovr.id2 == id2) || (ovr.id1 == id2 && ovr.id2 == id1))
+        {
+            ovr.props = props;
+            rebuild();
+            return;
+        }
+    m_overrides.push_back({id1, id2, props});
+    rebuild();
+}
+
+const material2D &material_table2D::operator[](const material_id id) const
+{
+    KIT_ASSERT_ERROR(id < m_materials.size(), "Material id out of bounds: {0}", id)
+    return m_materials[id];
+}
+
+const material_table2D::pair_properties &material_table2D::combine(const material_id id1,
+                                                                  const material_id id2) const
+{
+    KIT_ASSERT_WARN(contains(id1) && contains(id2), "Material id out of bounds, falling back to material 0")
+    const std::size_t index1 = contains(id1) ? id1 : 0;
+    const std::size_t index2 = contains(id2) ? id2 : 0;
+    return m_pairs[index1 * m_materials.size() + index2];
+}
+
+// a collider without a material combines as if its material had its own values and geometric mean modes, which never
+// win over the modes of the other material
+material_table2D::pair_properties material_table2D::combine(const material_id id, const surface2D &surface) const
+{
+    KIT_ASSERT_WARN(contains(id), "Material id out of bounds, falling back to material 0")
+    const std::size_t index = contains(id) ? id : 0;
+    const material2D &mat = m_materials[index];
+    const surface2D &msurface = m_surfaces[index];
+    constexpr material2D::combine_mode mean = material2D::combine_mode::GEOMETRIC_MEAN;
+    return {combine_values(msurface.friction, surface.friction, msurface.friction_root, surface.friction_root,
+                           mat.friction_combine, mean),
+            combine_values(msurface.restitution, surface.restitution, msurface.restitution_root,
+                           surface.restitution_root, mat.restitution_combine, mean)};
+}
+
+material_table2D::pair_properties material_table2D::combine(const surface2D &surface1, const surface2D &surface2) const
+{
+    return {surface1.friction_root * surface2.friction_root, surface1.restitution_root * surface2.restitution_root};
+}
+
+bool material_table2D::contains(const material_id id) const
+{
+    return id < m_materials.size();
+}
+
+const std::vector<material_table2D::pair_override> &material_table2D::overrides() const
+{
+    return m_overrides;
+}
+
+std::size_t material_table2D::size() const
+{
+    return m_materials.size();
+}
+
+void material_table2D::clear()
+{
+    m_materials.assign(1, material2D{});
+    m_overrides.clear();
+    rebuild();
+}
+
+void material_table2D::rebuild()
+{
+    const std::size_t count = m_materials.size();
+    m_surfaces.clear();
+    for (const material2D &mat : m_materials)
+        m_surfaces.push_back(surface2D::resolve(mat.friction, mat.restitution));
+
+    m_pairs.resize(count * count);
+    for (std::size_t i = 0; i < count; i++)
+        for (std::size_t j = 0; j < count; j++)
+        {
+            const material2D &mat1 = m_materials[i];
+            const material2D &mat2 = m_materials[j];
+            const surface2D &srf1 = m_surfaces[i];
+            const surface2D &srf2 = m_surfaces[j];
+            m_pairs[i * count + j] = {
+                combine_values(srf1.friction, srf2.friction, srf1.friction_root, srf2.friction_root,
+                               mat1.friction_combine, mat2.friction_combine),
+                combine_values(srf1.restitution, srf2.restitution, srf1.restitution_root, srf2.restitution_root,
+                               mat1.restitution_combine, mat2.restitution_combine)};
+        }
+    for (const pair_override &ovr : m_overrides)
+    {
+        m_pairs[ovr.id1 * count + ovr.id2] = ovr.props;
+        m_pairs[ovr.id2 * count + ovr.id1] = ovr.props;
+    }
+}
+} // namespace ppx
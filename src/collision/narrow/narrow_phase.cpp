@@ -9,21 +9,25 @@ void narrow_phase2D::update_contacts(const std::vector<pair> &pairs, icontact_ma
 {
     KIT_PERF_SCOPE("ppx::narrow_phase2D::update_contacts")
     m_contacts = contacts;
+    m_speculative = params.speculative_contacts && dynamic_cast<icontact_constraint_manager2D *>(contacts);
     if (params.multithreading && world.thread_pool)
         update_contacts_mt(pairs);
     else
         update_contacts_st(pairs);
 }
 
-static bool is_potential_collision(const collider2D *collider1,
-                                   const collider2D *collider2) // this must be tuned
+static bool is_potential_collision(const collider2D *collider1, const collider2D *collider2,
+                                   const bool speculative) // this must be tuned
 {
     const body2D *body1 = collider1->body();
     const body2D *body2 = collider2->body();
+    // speculative contacts need the velocity enlarged boxes to catch pairs that are about to touch
+    const bool bbox_overlap = speculative ? geo::intersects(collider1->fat_bbox(), collider2->fat_bbox())
+                                          : geo::intersects(collider1->tight_bbox(), collider2->tight_bbox());
     return (body1->is_dynamic() || body2->is_dynamic()) && (!body1->asleep() || !body2->asleep()) &&
            (collider1->collision_filter.cgroups & collider2->collision_filter.collides_with) &&
-           (collider2->collision_filter.cgroups & collider1->collision_filter.collides_with) &&
-           geo::intersects(collider1->tight_bbox(), collider2->tight_bbox()) && !body1->joint_prevents_collision(body2);
+           (collider2->collision_filter.cgroups & collider1->collision_filter.collides_with) && bbox_overlap &&
+           !body1->joint_prevents_collision(body2);
 }
 
 void narrow_phase2D::update_contacts_st(const std::vector<pair> &pairs)
@@ -31,7 +35,7 @@ void narrow_phase2D::update_contacts_st(const std::vector<pair> &pairs)
     KIT_PERF_SCOPE("ppx::narrow_phase2D::update_contacts_st")
     for (const pair &p : pairs)
     {
-        if (!is_potential_collision(p.collider1, p.collider2))
+        if (!is_potential_collision(p.collider1, p.collider2, m_speculative))
             continue;
         const collision2D colis = generate_collision(p.collider1, p.collider2);
         if (!colis.collided)
@@ -52,7 +56,7 @@ void narrow_phase2D::update_contacts_mt(const std::vector<pair> &pairs)
         {
             collider2D *collider1 = it->collider1;
             collider2D *collider2 = it->collider2;
-            if (!is_potential_collision(collider1, collider2))
+            if (!is_potential_collision(collider1, collider2, m_speculative))
                 continue;
             collision2D colis = generate_collision(collider1, collider2);
             if (!colis.collided)
@@ -87,6 +91,11 @@ const char *narrow_phase2D::name() const
     return "Unnamed";
 }
 
+narrow_phase2D::result narrow_phase2D::polygon_polygon(const collider2D &collider1, const collider2D &collider2) const
+{
+    return polygon_polygon(collider1.shape<polygon>(), collider2.shape<polygon>());
+}
+
 narrow_phase2D::result::operator bool() const
 {
     return intersects;
@@ -103,6 +112,9 @@ collision2D narrow_phase2D::generate_collision(collider2D *collider1, collider2D
         cp_narrow_collision_check(collider2, collider1, collision);
     else if (collider1->is_circle() && collider2->is_polygon())
         cp_narrow_collision_check(collider1, collider2, collision);
+
+    if (m_speculative && !collision.collided)
+        speculative_collision_check(collider1, collider2, collision);
     return collision;
 }
 
@@ -112,8 +124,22 @@ static void fill_collision_data(collision2D &collision, collider2D *collider1, c
     collision.collided = true;
     collision.collider1 = collider1;
     collision.collider2 = collider2;
-    collision.friction = sqrtf(collider1->friction * collider2->friction);
-    collision.restitution = sqrtf(collider1->restitution * collider2->restitution);
+    // unknown materials behave as material 0
+    const material_table2D &materials = collider1->world.collisions.materials;
+    const std::uint32_t material1 = materials.contains(collider1->material()) ? collider1->material() : 0;
+    const std::uint32_t material2 = materials.contains(collider2->material()) ? collider2->material() : 0;
+
+    material_table2D::pair_properties props;
+    if (material1 != 0 && material2 != 0) [[likely]]
+        props = materials.combine(material1, material2);
+    else if (material1 != 0)
+        props = materials.combine(material1, collider2->surface());
+    else if (material2 != 0)
+        props = materials.combine(material2, collider1->surface());
+    else
+        props = materials.combine(collider1->surface(), collider2->surface());
+    collision.friction = props.friction;
+    collision.restitution = props.restitution;
     collision.mtv = mtv;
     collision.manifold = manifold;
 }
@@ -138,7 +164,7 @@ void narrow_phase2D::cp_narrow_collision_check(collider2D *collider1, collider2D
 {
     const circle &circ = collider1->shape<circle>();
     const polygon &poly = collider2->shape<polygon>();
-    const float R = circ.radius() + poly.radius();
+    const float R = collider1->radius() + collider2->radius();
     if (glm::distance2(circ.gcentroid(), poly.gcentroid()) > R * R)
         return;
 
@@ -151,17 +177,166 @@ void narrow_phase2D::cp_narrow_collision_check(collider2D *collider1, collider2D
 void narrow_phase2D::pp_narrow_collision_check(collider2D *collider1, collider2D *collider2,
                                                collision2D &collision) const
 {
-    const polygon &poly1 = collider1->shape<polygon>();
-    const polygon &poly2 = collider2->shape<polygon>();
-    const float R = poly1.radius() + poly2.radius();
-    if (glm::distance2(poly1.gcentroid(), poly2.gcentroid()) > R * R)
+    const float R = collider1->radius() + collider2->radius();
+    if (glm::distance2(collider1->gcentroid(), collider2->gcentroid()) > R * R)
         return;
 
-    const result nres = polygon_polygon(poly1, poly2);
+    const result nres = polygon_polygon(*collider1, *collider2);
     if (!nres)
         return;
 
     fill_collision_data(collision, collider1, collider2, nres.mtv, nres.manifold);
 }
 
+struct separation2D
+{
+    float distance = -FLT_MAX;
+    glm::vec2 normal{0.f}; // from the first shape to the second
+    glm::vec2 point{0.f};  // halfway across the gap
+    std::uint32_t feature = 0;
+};
+
+static separation2D circle_circle_separation(const circle &circ1, const circle &circ2)
+{
+    separation2D sep;
+    const glm::vec2 dir = circ2.gcentroid() - circ1.gcentroid();
+    const float length = glm::length(dir);
+    if (kit::approaches_zero(length))
+        return sep;
+    sep.normal = dir / length;
+    sep.distance = length - circ1.radius() - circ2.radius();
+    sep.point = circ1.gcentroid() + sep.normal * (circ1.radius() + 0.5f * sep.distance);
+    return sep;
+}
+
+// normal points outwards from the polygon. the closest feature is the deepest face or, past its ends, a corner
+static separation2D circle_polygon_separation(const circle &circ, const collider2D *collider)
+{
+    separation2D sep;
+    const auto &vertices = collider->shape<polygon>().vertices.globals;
+    const auto &lnormals = collider->lnormals();
+    const glm::mat2 rot = kit::transform2D<float>::rotation_matrix(collider->body()->rotation());
+
+    const glm::vec2 &center = circ.gcentroid();
+    std::size_t face = 0;
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        const glm::vec2 normal = rot * lnormals[i];
+        const float distance = glm::dot(normal, center - vertices[i]) - circ.radius();
+        if (distance > sep.distance)
+        {
+            sep.distance = distance;
+            sep.normal = normal;
+            sep.point = center - normal * (circ.radius() + 0.5f * distance);
+            sep.feature = (std::uint32_t)i;
+            face = i;
+        }
+    }
+    if (sep.distance <= 0.f)
+        return sep;
+
+    const std::size_t next = (face + 1) % vertices.size();
+    const glm::vec2 edge = vertices[next] - vertices[face];
+    const float along = glm::dot(center - vertices[face], edge);
+    std::size_t corner;
+    if (along < 0.f)
+        corner = face;
+    else if (along > glm::dot(edge, edge))
+        corner = next;
+    else
+        return sep;
+
+    const glm::vec2 dir = center - vertices[corner];
+    const float length = glm::length(dir);
+    sep.normal = dir / length;
+    sep.distance = length - circ.radius();
+    sep.point = vertices[corner] + 0.5f * sep.distance * sep.normal;
+    sep.feature = (std::uint32_t)corner | (1u << 8);
+    return sep;
+}
+
+// exact distance between separated polygons. the closest features always include a vertex of one of them, so every
+// vertex is checked against every edge of the other, which also covers the corner regions face normals alone miss.
+// the face separation is kept along the way to reject overlapping pairs
+static separation2D polygon_polygon_separation(const collider2D *collider1, const collider2D *collider2)
+{
+    separation2D sep;
+    float min_dist2 = FLT_MAX;
+    float face_distance = -FLT_MAX;
+    const auto check_vertices = [&sep, &min_dist2, &face_distance](const collider2D *reference,
+                                                                   const collider2D *incident, const bool flip) {
+        const auto &rvertices = reference->shape<polygon>().vertices.globals;
+        const auto &ivertices = incident->shape<polygon>().vertices.globals;
+        const auto &lnormals = reference->lnormals();
+        const glm::mat2 rot = kit::transform2D<float>::rotation_matrix(reference->body()->rotation());
+        for (std::size_t i = 0; i < rvertices.size(); i++)
+        {
+            const glm::vec2 normal = rot * lnormals[i];
+            const glm::vec2 &start = rvertices[i];
+            const glm::vec2 edge = rvertices[(i + 1) % rvertices.size()] - start;
+            const float edge_dist2 = glm::dot(edge, edge);
+            float distance = FLT_MAX;
+            for (std::size_t j = 0; j < ivertices.size(); j++)
+            {
+                distance = std::min(distance, glm::dot(normal, ivertices[j] - start));
+                const float along = std::clamp(glm::dot(ivertices[j] - start, edge) / edge_dist2, 0.f, 1.f);
+                const glm::vec2 closest = start + along * edge;
+                const glm::vec2 diff = ivertices[j] - closest;
+                const float dist2 = glm::dot(diff, diff);
+                // vertices behind the edge are closer to another one of its edges, or the polygons overlap
+                if (dist2 >= min_dist2 || glm::dot(diff, normal) <= 0.f)
+                    continue;
+                min_dist2 = dist2;
+                sep.normal = flip ? -diff : diff;
+                sep.point = closest + 0.5f * diff;
+                sep.feature = (std::uint32_t)((i << 8) | j | (flip ? 1u << 16 : 0u));
+            }
+            face_distance = std::max(face_distance, distance);
+        }
+    };
+    check_vertices(collider1, collider2, false);
+    check_vertices(collider2, collider1, true);
+    if (face_distance <= 0.f || min_dist2 == FLT_MAX || kit::approaches_zero(min_dist2))
+        return {};
+
+    sep.distance = glm::sqrt(min_dist2);
+    sep.normal /= sep.distance;
+    return sep;
+}
+
+void narrow_phase2D::speculative_collision_check(collider2D *collider1, collider2D *collider2,
+                                                 collision2D &collision) const
+{
+    separation2D sep;
+    if (collider1->is_circle() && collider2->is_circle())
+        sep = circle_circle_separation(collider1->shape<circle>(), collider2->shape<circle>());
+    else if (collider1->is_polygon() && collider2->is_polygon())
+        sep = polygon_polygon_separation(collider1, collider2);
+    else if (collider1->is_circle())
+    {
+        sep = circle_polygon_separation(collider1->shape<circle>(), collider2);
+        sep.normal = -sep.normal;
+    }
+    else
+        sep = circle_polygon_separation(collider2->shape<circle>(), collider1);
+
+    if (sep.distance <= 0.f)
+        return;
+
+    const glm::vec2 relvel =
+        collider2->body()->state().gvelocity_at(sep.point) - collider1->body()->state().gvelocity_at(sep.point);
+    const float approach = -glm::dot(relvel, sep.normal) * world.integrator.ts.value;
+    if (sep.distance > std::max(approach, 0.f) + params.speculative_margin)
+        return;
+
+    // a positive penetration marks the point as speculative: it holds the gap left to close
+    geo::contact_point2D cpoint;
+    cpoint.point = sep.point;
+    cpoint.penetration = sep.distance;
+    cpoint.id.key = sep.feature | (1u << 31);
+
+    const manifold2D manifold = {cpoint};
+    fill_collision_data(collision, collider1, collider2, sep.normal * sep.distance, manifold);
+}
+
 } // namespace ppx
@@ -35,4 +35,52 @@ narrow_phase2D::result sat_narrow2D::polygon_polygon(const polygon &poly1, const
     return result;
 }
 
+struct axis_penetration
+{
+    float depth = FLT_MAX;
+    glm::vec2 axis{0.f};
+};
+
+// edge normals come precomputed in the body frame, so only a rotation per collider is needed here
+static bool min_penetration(const collider2D &reference, const collider2D &incident, const bool flip,
+                            axis_penetration &result)
+{
+    const auto &rvertices = reference.shape<polygon>().vertices.globals;
+    const auto &ivertices = incident.shape<polygon>().vertices.globals;
+    const auto &lnormals = reference.lnormals();
+    const glm::mat2 rot = kit::transform2D<float>::rotation_matrix(reference.body()->rotation());
+
+    for (std::size_t i = 0; i < rvertices.size(); i++)
+    {
+        const glm::vec2 normal = rot * lnormals[i];
+        float separation = FLT_MAX;
+        for (const glm::vec2 &v : ivertices)
+            separation = std::min(separation, glm::dot(normal, v - rvertices[i]));
+        if (separation > 0.f)
+            return false;
+        if (-separation < result.depth)
+        {
+            result.depth = -separation;
+            result.axis = flip ? -normal : normal;
+        }
+    }
+    return true;
+}
+
+narrow_phase2D::result sat_narrow2D::polygon_polygon(const collider2D &collider1, const collider2D &collider2) const
+{
+    result result;
+    axis_penetration pen;
+    if (!min_penetration(collider1, collider2, false, pen) || !min_penetration(collider2, collider1, true, pen))
+        return result;
+
+    const glm::vec2 mtv = pen.axis * pen.depth;
+    result.manifold = geo::clipping_contacts(collider1.shape<polygon>(), collider2.shape<polygon>(), mtv);
+    if (result.manifold.empty())
+        return result;
+    result.intersects = true;
+    result.mtv = mtv;
+    return result;
+}
+
 } // namespace ppx
\ No newline at end of file
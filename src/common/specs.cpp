@@ -19,8 +19,8 @@ collider2D collider2D::from_instance(const ppx::collider2D &collider)
     {
         return {collider.lposition(),
                 collider.lrotation(),
-                {collider.density(), collider.charge_density(), collider.restitution, collider.friction,
-                 poly->vertices.model, 0.f, collider.shape_type(), collider.collision_filter}};
+                {collider.density(), collider.charge_density(), collider.restitution(), collider.friction(),
+                 poly->vertices.model, 0.f, collider.shape_type(), collider.collision_filter, collider.material()}};
     }
 
     const circle &circ = collider.shape<circle>();
@@ -28,11 +28,13 @@ collider2D collider2D::from_instance(const ppx::collider2D &collider)
             collider.lrotation(),
             {collider.density(),
              collider.charge_density(),
-             collider.restitution,
-             collider.friction,
+             collider.restitution(),
+             collider.friction(),
              {},
              circ.radius(),
-             collider.shape_type()}};
+             collider.shape_type(),
+             collider.collision_filter,
+             collider.material()}};
 }
 
 body2D body2D::from_instance(const ppx::body2D &body)
@@ -47,7 +49,8 @@ body2D body2D::from_instance(const ppx::body2D &body)
             body.velocity(),
             body.rotation(),
             body.angular_velocity(),
-            {body.mass(), body.charge(), colliders, body.type()}};
+            {body.mass(), body.charge(), colliders, body.type(), body.sleep_velocity_threshold(),
+             body.sleep_angular_velocity_threshold()}};
 }
 
 rotor_joint2D rotor_joint2D::from_instance(const ppx::rotor_joint2D &rotj)
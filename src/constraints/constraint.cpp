@@ -65,9 +65,38 @@ bool constraint2D::solve_positions()
     return true;
 }
 
+std::size_t constraint2D::direct_rows() const
+{
+    return 0;
+}
+void constraint2D::direct_jacobian(jacobian_row2D *) const
+{
+    KIT_ERROR("This constraint cannot be solved directly")
+}
+void constraint2D::direct_velocity_error(float *) const
+{
+    KIT_ERROR("This constraint cannot be solved directly")
+}
+void constraint2D::apply_direct_impulse(const float *)
+{
+    KIT_ERROR("This constraint cannot be solved directly")
+}
+
 bool constraint2D::is_constraint() const
 {
     return true;
 }
+const constraint_kind2D *constraint2D::kind() const
+{
+    return m_kind;
+}
+float constraint2D::impulse_delta() const
+{
+    return m_impulse_delta;
+}
+float constraint2D::accumulated_impulse() const
+{
+    return 0.f;
+}
 
 } // namespace ppx
\ No newline at end of file
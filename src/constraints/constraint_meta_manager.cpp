@@ -14,7 +14,8 @@ void constraint_meta_manager2D::solve_velocities(std::vector<state2D> &states)
         if (manager->enabled()) [[likely]]
             manager->startup(states);
 
-    for (std::size_t i = 0; i < params.velocity_iterations; i++)
+    const std::uint32_t viters = velocity_iterations();
+    for (std::size_t i = 0; i < viters; i++)
     {
         for (const auto &manager : this->m_elements)
             if (manager->enabled()) [[likely]]
@@ -22,12 +23,29 @@ void constraint_meta_manager2D::solve_velocities(std::vector<state2D> &states)
         if (m_contact_solver)
             m_contact_solver->solve_velocities();
     }
+    if (m_contact_solver)
+        m_contact_solver->store_impulses();
+}
+
+// joints have no separate position bias, so they are just iterated once more
+void constraint_meta_manager2D::relax_velocities()
+{
+    KIT_PERF_SCOPE("ppx::constraint_meta_manager2D::relax_velocities")
+    for (const auto &manager : this->m_elements)
+        if (manager->enabled()) [[likely]]
+            manager->solve_velocities();
+    if (m_contact_solver)
+    {
+        m_contact_solver->relax_velocities();
+        m_contact_solver->store_impulses();
+    }
 }
 
 void constraint_meta_manager2D::solve_positions(std::vector<state2D> &states)
 {
     KIT_PERF_SCOPE("ppx::constraint_meta_manager2D::solve_positions")
-    for (std::size_t i = 0; i < params.position_iterations; i++)
+    const std::uint32_t piters = position_iterations();
+    for (std::size_t i = 0; i < piters; i++)
     {
         bool solved = true;
         for (const auto &manager : this->m_elements)
@@ -39,4 +57,13 @@ void constraint_meta_manager2D::solve_positions(std::vector<state2D> &states)
             break;
     }
 }
+
+std::uint32_t constraint_meta_manager2D::velocity_iterations() const
+{
+    return params.soft_step ? 1 : params.velocity_iterations;
+}
+std::uint32_t constraint_meta_manager2D::position_iterations() const
+{
+    return params.soft_step ? 0 : params.position_iterations;
+}
 } // namespace ppx
\ No newline at end of file
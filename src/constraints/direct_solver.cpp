@@ -0,0 +1,297 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/constraints/direct_solver.hpp"
+#include "ppx/body/body.hpp"
+
+namespace ppx
+{
+void direct_solver2D::startup(std::vector<state2D> &states)
+{
+    m_states = &states;
+    m_constraints.clear();
+}
+
+bool direct_solver2D::add(constraint2D *constraint)
+{
+    if (constraint->direct_rows() == 0)
+        return false;
+    m_constraints.push_back(constraint);
+    return true;
+}
+
+void direct_solver2D::factorize()
+{
+    KIT_PERF_SCOPE("ppx::direct_solver2D::factorize")
+    if (m_constraints.empty())
+        return;
+    order_constraints();
+    build_envelope();
+    assemble();
+
+    const std::size_t rows = m_first_row.size();
+    m_inv_diagonal.resize(rows);
+    for (std::size_t i = 0; i < rows; i++)
+    {
+        const std::size_t fi = m_first_row[i];
+        double *row_i = m_envelope.data() + m_envelope_start[i];
+
+        // row_i temporarily holds L_ik * D_k for the columns already visited
+        for (std::size_t j = fi; j < i; j++)
+        {
+            const std::size_t fj = m_first_row[j];
+            const double *row_j = m_envelope.data() + m_envelope_start[j];
+            double g = row_i[j - fi];
+            for (std::size_t k = std::max(fi, fj); k < j; k++)
+                g -= row_j[k - fj] * row_i[k - fi];
+            row_i[j - fi] = g;
+        }
+
+        const double diagonal = row_i[i - fi];
+        double pivot = diagonal;
+        for (std::size_t k = fi; k < i; k++)
+        {
+            const double l = row_i[k - fi] * m_inv_diagonal[k];
+            pivot -= l * row_i[k - fi];
+            row_i[k - fi] = l;
+        }
+        m_inv_diagonal[i] = pivot > MIN_PIVOT * diagonal ? 1.0 / pivot : 0.0;
+    }
+}
+
+float direct_solver2D::solve_velocities()
+{
+    KIT_PERF_SCOPE("ppx::direct_solver2D::solve_velocities")
+    if (m_constraints.empty())
+        return 0.f;
+
+    const std::size_t rows = m_first_row.size();
+    for (std::size_t i = 0; i < m_order.size(); i++)
+        m_constraints[m_order[i]]->direct_velocity_error(m_errors.data() + m_offsets[i]);
+
+    // L D L^T x = -error, forward and backward substitution over the envelope
+    for (std::size_t i = 0; i < rows; i++)
+    {
+        const std::size_t fi = m_first_row[i];
+        const double *row_i = m_envelope.data() + m_envelope_start[i];
+        double y = -(double)m_errors[i];
+        for (std::size_t k = fi; k < i; k++)
+            y -= row_i[k - fi] * m_scratch[k];
+        m_scratch[i] = y;
+    }
+    for (std::size_t i = 0; i < rows; i++)
+        m_scratch[i] *= m_inv_diagonal[i];
+    for (std::size_t i = rows; i-- > 0;)
+    {
+        const std::size_t fi = m_first_row[i];
+        const double *row_i = m_envelope.data() + m_envelope_start[i];
+        const double x = m_scratch[i];
+        for (std::size_t k = fi; k < i; k++)
+            m_scratch[k] -= row_i[k - fi] * x;
+        m_impulses[i] = (float)x;
+    }
+
+    float residual = 0.f;
+    for (std::size_t i = 0; i < m_order.size(); i++)
+    {
+        constraint2D *constraint = m_constraints[m_order[i]];
+        constraint->apply_direct_impulse(m_impulses.data() + m_offsets[i]);
+        residual = std::max(residual, constraint->impulse_delta());
+    }
+    return residual;
+}
+
+// reverse cuthill mckee over the graph in which two constraints are adjacent if they share a dynamic body
+void direct_solver2D::order_constraints()
+{
+    const std::vector<state2D> &states = *m_states;
+    m_adjacency.clear();
+    for (std::size_t i = 0; i < m_constraints.size(); i++)
+    {
+        const std::size_t index1 = m_constraints[i]->body1()->meta.index;
+        const std::size_t index2 = m_constraints[i]->body2()->meta.index;
+        if (states[index1].is_dynamic())
+            m_adjacency.push_back({index1, i});
+        if (states[index2].is_dynamic())
+            m_adjacency.push_back({index2, i});
+    }
+    std::sort(m_adjacency.begin(), m_adjacency.end(), [](const body_constraint &bc1, const body_constraint &bc2) {
+        return bc1.body < bc2.body || (bc1.body == bc2.body && bc1.constraint < bc2.constraint);
+    });
+
+    // each constraint keeps the adjacency ranges of its (up to two) dynamic bodies
+    const std::size_t count = m_constraints.size();
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(2 * count, {0, 0});
+    std::vector<std::size_t> degrees(count, 0);
+    for (std::size_t begin = 0; begin < m_adjacency.size();)
+    {
+        std::size_t end = begin + 1;
+        while (end < m_adjacency.size() && m_adjacency[end].body == m_adjacency[begin].body)
+            end++;
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const std::size_t constraint = m_adjacency[i].constraint;
+            auto &range = ranges[2 * constraint].second == 0 ? ranges[2 * constraint] : ranges[2 * constraint + 1];
+            range = {begin, end};
+            degrees[constraint] += end - begin - 1;
+        }
+        begin = end;
+    }
+
+    const auto by_degree = [&degrees](const std::size_t c1, const std::size_t c2) {
+        return degrees[c1] < degrees[c2];
+    };
+    std::vector<std::size_t> starts(count);
+    for (std::size_t i = 0; i < count; i++)
+        starts[i] = i;
+    std::sort(starts.begin(), starts.end(), by_degree);
+
+    // every connected component is started from its lowest degree constraint
+    m_order.clear();
+    std::vector<bool> visited(count, false);
+    std::vector<std::size_t> neighbours;
+    for (const std::size_t start : starts)
+    {
+        if (visited[start])
+            continue;
+        visited[start] = true;
+        m_order.push_back(start);
+
+        for (std::size_t head = m_order.size() - 1; head < m_order.size(); head++)
+        {
+            const std::size_t constraint = m_order[head];
+            neighbours.clear();
+            for (std::size_t r = 2 * constraint; r < 2 * constraint + 2; r++)
+                for (std::size_t i = ranges[r].first; i < ranges[r].second; i++)
+                {
+                    const std::size_t neighbour = m_adjacency[i].constraint;
+                    if (!visited[neighbour])
+                    {
+                        visited[neighbour] = true;
+                        neighbours.push_back(neighbour);
+                    }
+                }
+            std::sort(neighbours.begin(), neighbours.end(), by_degree);
+            m_order.insert(m_order.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+    std::reverse(m_order.begin(), m_order.end());
+}
+
+void direct_solver2D::build_envelope()
+{
+    const std::size_t count = m_order.size();
+    std::vector<std::size_t> positions(count);
+    m_offsets.resize(count);
+
+    std::size_t rows = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        positions[m_order[i]] = i;
+        m_offsets[i] = rows;
+        rows += m_constraints[m_order[i]]->direct_rows();
+    }
+
+    // the first coupled row of a constraint is the first row of its earliest neighbour (or its own)
+    std::vector<std::size_t> first(count);
+    for (std::size_t i = 0; i < count; i++)
+        first[i] = m_offsets[i];
+    for (std::size_t begin = 0; begin < m_adjacency.size();)
+    {
+        std::size_t end = begin + 1;
+        while (end < m_adjacency.size() && m_adjacency[end].body == m_adjacency[begin].body)
+            end++;
+        std::size_t group_first = SIZE_MAX;
+        for (std::size_t i = begin; i < end; i++)
+            group_first = std::min(group_first, m_offsets[positions[m_adjacency[i].constraint]]);
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const std::size_t position = positions[m_adjacency[i].constraint];
+            first[position] = std::min(first[position], group_first);
+        }
+        begin = end;
+    }
+
+    m_first_row.resize(rows);
+    m_envelope_start.resize(rows);
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const std::size_t end = i + 1 < count ? m_offsets[i + 1] : rows;
+        for (std::size_t row = m_offsets[i]; row < end; row++)
+        {
+            m_first_row[row] = first[i];
+            m_envelope_start[row] = size;
+            size += row - first[i] + 1;
+        }
+    }
+    m_envelope.assign(size, 0.0);
+    m_scratch.resize(rows);
+    m_errors.resize(rows);
+    m_impulses.resize(rows);
+    m_jacobian.resize(rows);
+
+    // adjacency constraints are remapped to their elimination position from now on
+    for (body_constraint &bc : m_adjacency)
+        bc.constraint = positions[bc.constraint];
+}
+
+void direct_solver2D::assemble()
+{
+    const std::vector<state2D> &states = *m_states;
+    for (std::size_t i = 0; i < m_order.size(); i++)
+        m_constraints[m_order[i]]->direct_jacobian(m_jacobian.data() + m_offsets[i]);
+
+    const auto row_end = [this](const std::size_t position) {
+        return position + 1 < m_offsets.size() ? m_offsets[position + 1] : m_first_row.size();
+    };
+    const auto body_row = [this](const std::size_t position, const std::size_t row, const std::size_t body) {
+        const jacobian_row2D &jrow = m_jacobian[row];
+        return m_constraints[m_order[position]]->body1()->meta.index == body ? jrow.body1 : jrow.body2;
+    };
+
+    // every dynamic body couples all the rows of the constraints attached to it: K += J_b W_b J_b^T
+    for (std::size_t begin = 0; begin < m_adjacency.size();)
+    {
+        const std::size_t body = m_adjacency[begin].body;
+        std::size_t end = begin + 1;
+        while (end < m_adjacency.size() && m_adjacency[end].body == body)
+            end++;
+
+        const state2D &state = states[body];
+        const glm::vec3 weights{state.inv_mass(), state.inv_mass(), state.inv_inertia()};
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const std::size_t position1 = m_adjacency[i].constraint;
+            for (std::size_t j = begin; j < end; j++)
+            {
+                const std::size_t position2 = m_adjacency[j].constraint;
+                for (std::size_t row1 = m_offsets[position1]; row1 < row_end(position1); row1++)
+                {
+                    const glm::vec3 weighted = weights * body_row(position1, row1, body);
+                    for (std::size_t row2 = m_offsets[position2]; row2 < row_end(position2) && row2 <= row1; row2++)
+                        entry(row1, row2) += (double)glm::dot(weighted, body_row(position2, row2, body));
+                }
+            }
+        }
+        begin = end;
+    }
+}
+
+double &direct_solver2D::entry(const std::size_t row, const std::size_t col)
+{
+    return m_envelope[m_envelope_start[row] + col - m_first_row[row]];
+}
+
+const std::vector<constraint2D *> &direct_solver2D::constraints() const
+{
+    return m_constraints;
+}
+std::size_t direct_solver2D::size() const
+{
+    return m_constraints.size();
+}
+bool direct_solver2D::empty() const
+{
+    return m_constraints.empty();
+}
+
+} // namespace ppx
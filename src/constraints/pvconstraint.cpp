@@ -7,16 +7,12 @@ namespace ppx
 template <std::size_t LinDegrees, std::size_t AngDegrees>
     requires LegalDegrees2D<LinDegrees, AngDegrees>
 typename pvconstraint2D<LinDegrees, AngDegrees>::flat_t pvconstraint2D<LinDegrees,
-                                                                       AngDegrees>::compute_constraint_impulse() const
+                                                                       AngDegrees>::biased_constraint_velocity() const
 {
     flat_t cvel = this->constraint_velocity();
     if (m_baumgarte && glm::length(m_c) > m_bthreshold)
         cvel += m_bcoeff * m_c / this->m_ts;
-
-    if constexpr (LinDegrees + AngDegrees == 1)
-        return -cvel * this->m_mass;
-    else
-        return this->m_mass * (-cvel);
+    return cvel;
 }
 
 template <std::size_t LinDegrees, std::size_t AngDegrees>
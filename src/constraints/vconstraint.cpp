@@ -6,15 +6,31 @@
 
 namespace ppx
 {
+template <typename T> static float magnitude(const T &impulse)
+{
+    if constexpr (std::is_same_v<T, float>)
+        return glm::abs(impulse);
+    else
+        return glm::length(impulse);
+}
+
 template <std::size_t LinDegrees, std::size_t AngDegrees>
     requires LegalDegrees2D<LinDegrees, AngDegrees>
 typename vconstraint2D<LinDegrees, AngDegrees>::flat_t vconstraint2D<LinDegrees,
                                                                      AngDegrees>::compute_constraint_impulse() const
 {
     if constexpr (LinDegrees + AngDegrees == 1)
-        return -constraint_velocity() * m_mass;
+        return -biased_constraint_velocity() * m_mass;
     else
-        return m_mass * (-constraint_velocity());
+        return m_mass * (-biased_constraint_velocity());
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+typename vconstraint2D<LinDegrees, AngDegrees>::flat_t vconstraint2D<LinDegrees,
+                                                                     AngDegrees>::biased_constraint_velocity() const
+{
+    return constraint_velocity();
 }
 
 template <std::size_t LinDegrees, std::size_t AngDegrees>
@@ -109,8 +125,15 @@ template <std::size_t LinDegrees, std::size_t AngDegrees>
     requires LegalDegrees2D<LinDegrees, AngDegrees>
 void vconstraint2D<LinDegrees, AngDegrees>::solve_velocities()
 {
-    const flat_t impulse = compute_constraint_impulse();
+    apply_constraint_impulse(compute_constraint_impulse());
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+void vconstraint2D<LinDegrees, AngDegrees>::apply_constraint_impulse(const flat_t &impulse)
+{
     m_cumimpulse += impulse;
+    m_impulse_delta = magnitude(impulse);
     if constexpr (LinDegrees > 0)
         apply_linear_impulse(compute_linear_impulse(impulse));
     if constexpr (AngDegrees == 1)
@@ -126,6 +149,7 @@ void vconstraint2D<LinDegrees, AngDegrees>::solve_velocities_clamped(const flat_
     m_cumimpulse = glm::clamp(m_cumimpulse + impulse, min, max);
 
     const flat_t delta_impulse = m_cumimpulse - old_impulse;
+    m_impulse_delta = magnitude(delta_impulse);
     if constexpr (LinDegrees > 0)
     {
         const glm::vec2 linimpulse = compute_linear_impulse(delta_impulse);
@@ -145,28 +169,45 @@ template <std::size_t LinDegrees, std::size_t AngDegrees>
 void vconstraint2D<LinDegrees, AngDegrees>::startup(std::vector<state2D> &states)
 {
     m_states = &states;
-    m_index1 = m_body1->meta.index;
-    m_index2 = m_body2->meta.index;
-
-    const state2D &st1 = state1();
-    m_imass1 = st1.inv_mass();
-    m_iinertia1 = st1.inv_inertia();
-    m_dyn1 = st1.is_dynamic();
-
-    const state2D &st2 = state2();
-    m_imass2 = st2.inv_mass();
-    m_iinertia2 = st2.inv_inertia();
-    m_dyn2 = st2.is_dynamic();
-
     m_ts = world.rk_timestep();
+    m_impulse_delta = 0.f;
+
+    // masses and indices do not change between stages
+    const std::uint32_t step = world.step_count();
+    const bool new_step = step != m_startup_step;
+    if (new_step)
+    {
+        m_startup_step = step;
+        m_stale_mass = true;
+        m_index1 = m_body1->meta.index;
+        m_index2 = m_body2->meta.index;
+
+        const state2D &st1 = state1();
+        m_imass1 = st1.inv_mass();
+        m_iinertia1 = st1.inv_inertia();
+        m_dyn1 = st1.is_dynamic();
+
+        const state2D &st2 = state2();
+        m_imass2 = st2.inv_mass();
+        m_iinertia2 = st2.inv_inertia();
+        m_dyn2 = st2.is_dynamic();
+    }
 
-    update_constraint_data();
+    if (new_step || !world.joints.constraints.params.freeze_jacobians)
+        update_constraint_data();
     if (world.joints.constraints.params.warmup)
         warmup();
     else
         m_cumimpulse = flat_t(0.f);
 }
 
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+float vconstraint2D<LinDegrees, AngDegrees>::accumulated_impulse() const
+{
+    return magnitude(m_cumimpulse);
+}
+
 template <std::size_t LinDegrees, std::size_t AngDegrees>
     requires LegalDegrees2D<LinDegrees, AngDegrees>
 const state2D &vconstraint2D<LinDegrees, AngDegrees>::state1() const
@@ -202,7 +243,14 @@ void vconstraint2D<LinDegrees, AngDegrees>::update_constraint_data()
     compute_anchors_and_offsets(state1(), state2());
     if constexpr (LinDegrees == 1)
         this->m_dir = this->direction();
+
+    // purely angular constraints do not depend on the offsets, so their mass only changes with the timestep if soft
+    if constexpr (LinDegrees == 0)
+        if (!m_stale_mass && (!m_is_soft || m_mass_ts == m_ts))
+            return;
     m_mass = mass();
+    m_mass_ts = m_ts;
+    m_stale_mass = false;
 }
 
 template <typename Mat> static Mat invert_diagonal(const Mat &mat)
@@ -336,6 +384,64 @@ void vconstraint2D<LinDegrees, AngDegrees>::warmup()
         apply_angular_impulse(compute_angular_impulse(m_cumimpulse));
 }
 
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+bool vconstraint2D<LinDegrees, AngDegrees>::is_equality() const
+{
+    return false;
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+std::size_t vconstraint2D<LinDegrees, AngDegrees>::direct_rows() const
+{
+    return is_equality() && !m_is_soft && !m_position_based ? DIMENSION : 0;
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+void vconstraint2D<LinDegrees, AngDegrees>::direct_jacobian(jacobian_row2D *rows) const
+{
+    std::size_t row = 0;
+    if constexpr (LinDegrees == 1)
+    {
+        const glm::vec2 &dir = this->m_dir;
+        rows[row++] = {{-dir, -kit::cross2D(m_offset1, dir)}, {dir, kit::cross2D(m_offset2, dir)}};
+    }
+    else if constexpr (LinDegrees == 2)
+    {
+        rows[row++] = {{-1.f, 0.f, m_offset1.y}, {1.f, 0.f, -m_offset2.y}};
+        rows[row++] = {{0.f, -1.f, -m_offset1.x}, {0.f, 1.f, m_offset2.x}};
+    }
+    if constexpr (AngDegrees == 1)
+        rows[row] = {{0.f, 0.f, -1.f}, {0.f, 0.f, 1.f}};
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+void vconstraint2D<LinDegrees, AngDegrees>::direct_velocity_error(float *errors) const
+{
+    const flat_t cvel = biased_constraint_velocity();
+    if constexpr (DIMENSION == 1)
+        errors[0] = cvel;
+    else
+        for (glm::length_t i = 0; i < (glm::length_t)DIMENSION; i++)
+            errors[i] = cvel[i];
+}
+
+template <std::size_t LinDegrees, std::size_t AngDegrees>
+    requires LegalDegrees2D<LinDegrees, AngDegrees>
+void vconstraint2D<LinDegrees, AngDegrees>::apply_direct_impulse(const float *impulses)
+{
+    flat_t impulse;
+    if constexpr (DIMENSION == 1)
+        impulse = impulses[0];
+    else
+        for (glm::length_t i = 0; i < (glm::length_t)DIMENSION; i++)
+            impulse[i] = impulses[i];
+    apply_constraint_impulse(impulse);
+}
+
 template class vconstraint2D<1, 0>;
 template class vconstraint2D<0, 1>;
 template class vconstraint2D<1, 1>;
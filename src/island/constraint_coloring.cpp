@@ -0,0 +1,61 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/island/constraint_coloring.hpp"
+#include <bit>
+
+namespace ppx
+{
+void constraint_coloring2D::begin(const std::size_t body_count)
+{
+    // only the masks written by the previous coloring are reset, so that small islands do not pay for the whole world
+    if (m_body_colors.size() < body_count)
+        m_body_colors.resize(body_count, 0);
+    for (const std::size_t index : m_touched_bodies)
+        m_body_colors[index] = 0;
+    m_touched_bodies.clear();
+
+    for (std::vector<std::size_t> &color : m_colors)
+        color.clear();
+    m_overflow.clear();
+}
+
+void constraint_coloring2D::add(const std::size_t item, const std::size_t index1, const std::size_t index2,
+                                const bool dynamic1, const bool dynamic2)
+{
+    constexpr std::uint32_t all_colors = (1u << MAX_COLORS) - 1;
+    const std::uint32_t used = (dynamic1 ? m_body_colors[index1] : 0) | (dynamic2 ? m_body_colors[index2] : 0);
+    const std::uint32_t available = ~used & all_colors;
+    if (available == 0)
+    {
+        m_overflow.push_back(item);
+        return;
+    }
+
+    const std::uint32_t color = (std::uint32_t)std::countr_zero(available);
+    const std::uint32_t bit = 1u << color;
+    if (color >= m_colors.size())
+        m_colors.resize(color + 1);
+    m_colors[color].push_back(item);
+
+    if (dynamic1)
+    {
+        if (m_body_colors[index1] == 0)
+            m_touched_bodies.push_back(index1);
+        m_body_colors[index1] |= bit;
+    }
+    if (dynamic2)
+    {
+        if (m_body_colors[index2] == 0)
+            m_touched_bodies.push_back(index2);
+        m_body_colors[index2] |= bit;
+    }
+}
+
+const std::vector<std::vector<std::size_t>> &constraint_coloring2D::colors() const
+{
+    return m_colors;
+}
+const std::vector<std::size_t> &constraint_coloring2D::overflow() const
+{
+    return m_overflow;
+}
+} // namespace ppx
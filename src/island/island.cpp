@@ -2,6 +2,9 @@
 #include "ppx/island/island.hpp"
 #include "ppx/body/body_manager.hpp"
 #include "ppx/world.hpp"
+#include "kit/multithreading/mt_for_each.hpp"
+#include <bit>
+#include <tuple>
 
 namespace ppx
 {
@@ -11,7 +14,7 @@ void island2D::add_body(body2D *body)
     KIT_ASSERT_ERROR(body->meta.island != this, "Body already in island")
     KIT_ASSERT_ERROR(std::find(m_bodies.begin(), m_bodies.end(), body) == m_bodies.end(),
                      "Body already in island, but not labeled as such")
-    m_bodies.push_back(body);
+    push_back(m_bodies, body, &body2D::metadata::island_slot);
     body->meta.island = this;
     awake();
 }
@@ -22,6 +25,7 @@ void island2D::awake()
         return;
     m_asleep = false;
     m_time_still = 0.f;
+    world.collisions.contact_manager()->unpark_contacts(m_contacts);
 }
 bool island2D::asleep() const
 {
@@ -32,51 +36,150 @@ bool island2D::about_to_sleep() const
     const float percent = 0.35f;
     return m_time_still > percent * world.islands.params.sleep_time_threshold;
 }
+// islands that lost a joint or a contact since the last check. those about to sleep keep their contacts for a while
 bool island2D::evaluate_split_candidate()
 {
-    if (m_may_split)
-        return true;
-    if (is_void() || m_merged || !m_lost_contact || (!m_asleep && about_to_sleep()))
-    {
-        m_split_points = 0;
+    if (is_void() || m_merged)
+        return false;
+    const bool candidate = m_may_split || (m_lost_contact && (m_asleep || !about_to_sleep()));
+    m_may_split = false;
+    if (!candidate) // a lost contact is remembered until the island can be checked, even if it falls asleep first
         return false;
+    m_lost_contact = false;
+    return m_bodies.size() > 1;
+}
+
+std::size_t island2D::find_components()
+{
+    KIT_PERF_SCOPE("ppx::island2D::find_components")
+    m_components.resize(m_bodies.size());
+    for (std::size_t i = 0; i < m_components.size(); i++)
+        m_components[i] = i;
+
+    m_component_count = m_bodies.size();
+    const auto unite = [this](const joint2D *joint) {
+        const body2D *body1 = joint->body1();
+        const body2D *body2 = joint->body2();
+        if (!body1->is_dynamic() || !body2->is_dynamic())
+            return;
+        std::size_t root1 = component_root(body1->meta.island_slot);
+        std::size_t root2 = component_root(body2->meta.island_slot);
+        if (root1 == root2)
+            return;
+
+        // the lowest slot is always the root, so that components can be labeled in a single forward pass later
+        if (root1 > root2)
+            std::swap(root1, root2);
+        m_components[root2] = root1;
+        m_component_count--;
+    };
+    for (const actuator2D *actuator : m_actuators)
+        unite(actuator);
+    for (const constraint2D *constraint : m_constraints)
+        unite(constraint);
+    for (const contact2D *contact : m_contacts)
+        unite(contact);
+    if (m_component_count == 1)
+        return 1;
+
+    // parents always have a lower slot than their children, so roots and labels can be resolved in slot order
+    std::size_t label = 0;
+    for (std::size_t i = 0; i < m_components.size(); i++)
+        m_components[i] = m_components[i] == i ? label++ : m_components[m_components[i]];
+    return m_component_count;
+}
+
+std::size_t island2D::component_root(std::size_t slot)
+{
+    while (m_components[slot] != slot)
+    {
+        m_components[slot] = m_components[m_components[slot]]; // path halving
+        slot = m_components[slot];
     }
-    return m_split_points++ > world.islands.params.steps_to_split;
+    return slot;
+}
+
+std::size_t island2D::component_of(const joint2D *joint) const
+{
+    const body2D *body = joint->body1()->is_dynamic() ? joint->body1() : joint->body2();
+    return m_components[body->meta.island_slot];
 }
 
 void island2D::remove_body(body2D *body)
 {
-    for (std::size_t i = 0; i < m_bodies.size(); i++)
-        if (m_bodies[i] == body)
-        {
-            m_bodies.erase(m_bodies.begin() + i);
-            body->meta.island = nullptr;
-            awake();
-            m_may_split = true;
-            if (no_bodies())
-                world.islands.remove(this);
-            return;
-        }
-    KIT_WARN("Body not found in island");
+    if (!swap_remove(m_bodies, body, &body2D::metadata::island_slot))
+    {
+        KIT_WARN("Body not found in island");
+        return;
+    }
+    body->meta.island = nullptr;
+    awake();
+    m_may_split = true;
+    world.islands.m_layout_changed = true;
+    if (no_bodies())
+        world.islands.remove(this);
 }
 
 void island2D::merge(island2D &island)
 {
     KIT_PERF_SCOPE("ppx::island2D::merge")
+    island.awake(); // its contacts may be parked, and this island may already be awake
     for (body2D *body : island.m_bodies)
     {
         KIT_ASSERT_ERROR(body->is_dynamic(), "Body must be dynamic")
         KIT_ASSERT_ERROR(std::find(m_bodies.begin(), m_bodies.end(), body) == m_bodies.end(), "Body already in island")
-        m_bodies.push_back(body);
+        push_back(m_bodies, body, &body2D::metadata::island_slot);
         body->meta.island = this;
     }
-    m_actuators.insert(m_actuators.end(), island.m_actuators.begin(), island.m_actuators.end());
-    m_constraints.insert(m_constraints.end(), island.m_constraints.begin(), island.m_constraints.end());
-    m_contacts.insert(m_contacts.end(), island.m_contacts.begin(), island.m_contacts.end());
+    append(m_actuators, island.m_actuators, &joint2D::metadata::island_slot);
+    append(m_constraints, island.m_constraints, &joint2D::metadata::island_slot);
+    append(m_packed_contacts, island.m_packed_contacts, &joint2D::metadata::island_slot);
+    append(m_contacts, island.m_contacts, &joint2D::metadata::island_contact_slot);
     island.m_merged = true;
+    world.islands.m_layout_changed = true;
     awake();
 }
 
+static std::pair<std::size_t, std::size_t> body_indices(const joint2D *joint)
+{
+    const std::size_t index1 = joint->body1()->meta.index;
+    const std::size_t index2 = joint->body2()->meta.index;
+    return {std::min(index1, index2), std::max(index1, index2)};
+}
+
+// rows touching lower body indices first, so that a sweep walks the state array mostly forward. contacts are further
+// ordered by collider pair and feature, which keeps the points of a manifold together and the order deterministic
+void island2D::sort_by_bodies()
+{
+    const auto by_bodies = [](const joint2D *joint1, const joint2D *joint2) {
+        return body_indices(joint1) < body_indices(joint2);
+    };
+    const auto by_bodies_and_key = [](const contact2D *contact1, const contact2D *contact2) {
+        const contact2D::contact_key key1 = contact1->key();
+        const contact2D::contact_key key2 = contact2->key();
+        return std::tuple(body_indices(contact1), key1.colliders, key1.feature) <
+               std::tuple(body_indices(contact2), key2.colliders, key2.feature);
+    };
+    std::stable_sort(m_actuators.begin(), m_actuators.end(), by_bodies);
+    std::stable_sort(m_constraints.begin(), m_constraints.end(), by_bodies);
+    std::stable_sort(m_packed_contacts.begin(), m_packed_contacts.end(), by_bodies_and_key);
+    reindex();
+}
+
+void island2D::reindex()
+{
+    for (std::size_t i = 0; i < m_bodies.size(); i++)
+        m_bodies[i]->meta.island_slot = i;
+    for (std::size_t i = 0; i < m_actuators.size(); i++)
+        m_actuators[i]->meta.island_slot = i;
+    for (std::size_t i = 0; i < m_constraints.size(); i++)
+        m_constraints[i]->meta.island_slot = i;
+    for (std::size_t i = 0; i < m_packed_contacts.size(); i++)
+        m_packed_contacts[i]->meta.island_slot = i;
+    for (std::size_t i = 0; i < m_contacts.size(); i++)
+        m_contacts[i]->meta.island_contact_slot = i;
+}
+
 const std::vector<body2D *> &island2D::bodies() const
 {
     return m_bodies;
@@ -89,6 +192,10 @@ const std::vector<constraint2D *> &island2D::constraints() const
 {
     return m_constraints;
 }
+const std::vector<nonpen_contact2D *> &island2D::packed_contacts() const
+{
+    return m_packed_contacts;
+}
 
 bool island2D::checksum() const
 {
@@ -96,10 +203,13 @@ bool island2D::checksum() const
     const std::unordered_set<const actuator2D *> actuators(m_actuators.begin(), m_actuators.end());
     const std::unordered_set<const constraint2D *> constraints(m_constraints.begin(), m_constraints.end());
     const std::unordered_set<const contact2D *> contacts(m_contacts.begin(), m_contacts.end());
+    const std::unordered_set<const nonpen_contact2D *> packed_contacts(m_packed_contacts.begin(),
+                                                                       m_packed_contacts.end());
 
     std::unordered_set<const actuator2D *> body_actuators;
     std::unordered_set<const constraint2D *> body_constraints;
     std::unordered_set<const contact2D *> body_contacts;
+    std::unordered_set<const nonpen_contact2D *> body_packed_contacts;
     for (const body2D *body : m_bodies)
     {
         if (!body->is_dynamic())
@@ -148,14 +258,14 @@ bool island2D::checksum() const
                 return false;
             }
             body_contacts.insert(contact);
-            if (auto act = dynamic_cast<const actuator2D *>(contact))
+            if (auto packed = dynamic_cast<const nonpen_contact2D *>(contact))
             {
-                if (!actuators.contains(act))
+                if (!packed_contacts.contains(packed))
                 {
-                    KIT_ERROR("Island checksum failed: Actuator not found in actuator list")
+                    KIT_ERROR("Island checksum failed: Contact not found in packed contact list")
                     return false;
                 }
-                body_actuators.insert(act);
+                body_packed_contacts.insert(packed);
             }
             else if (auto con = dynamic_cast<const constraint2D *>(contact))
             {
@@ -179,16 +289,21 @@ bool island2D::checksum() const
     KIT_ASSERT_ERROR(body_constraints.size() == m_constraints.size(),
                      "Island checksum failed: Constraint count mismatch")
     KIT_ASSERT_ERROR(body_contacts.size() == m_contacts.size(), "Island checksum failed: Contact count mismatch")
+    KIT_ASSERT_ERROR(body_packed_contacts.size() == m_packed_contacts.size(),
+                     "Island checksum failed: Packed contact count mismatch")
 
     KIT_ASSERT_ERROR(bodies.size() == m_bodies.size(), "Island checksum failed: Duplicate bodies found")
     KIT_ASSERT_ERROR(actuators.size() == m_actuators.size(), "Island checksum failed: Duplicate actuators found")
     KIT_ASSERT_ERROR(constraints.size() == m_constraints.size(), "Island checksum failed: Duplicate constraints found")
     KIT_ASSERT_ERROR(contacts.size() == m_contacts.size(), "Island checksum failed: Duplicate contacts found")
+    KIT_ASSERT_ERROR(packed_contacts.size() == m_packed_contacts.size(),
+                     "Island checksum failed: Duplicate packed contacts found")
 
     return bodies.size() == m_bodies.size() && actuators.size() == m_actuators.size() &&
            constraints.size() == m_constraints.size() && contacts.size() == m_contacts.size() &&
-           body_actuators.size() == m_actuators.size() && body_constraints.size() == m_constraints.size() &&
-           body_contacts.size() == m_contacts.size();
+           packed_contacts.size() == m_packed_contacts.size() && body_actuators.size() == m_actuators.size() &&
+           body_constraints.size() == m_constraints.size() && body_contacts.size() == m_contacts.size() &&
+           body_packed_contacts.size() == m_packed_contacts.size();
 }
 
 void island2D::solve_actuators(std::vector<state2D> &states)
@@ -198,27 +313,232 @@ void island2D::solve_actuators(std::vector<state2D> &states)
             actuator->solve(states);
 }
 
-void island2D::solve_velocity_constraints(std::vector<state2D> &states)
+void island2D::solve_velocity_constraints(std::vector<state2D> &states, const bool colored)
 {
-    const std::size_t viters = world.joints.constraints.params.velocity_iterations;
+    const specs::joint_manager2D::constraints2D &params = world.joints.constraints.params;
+    const bool direct = params.direct_joint_solver && !colored;
+    for (constraint2D *constraint : m_constraints)
+        if (constraint->enabled()) [[likely]]
+            constraint->startup(states);
 
-    for (contact2D *contact : m_contacts)
+    m_contact_solver.startup(states);
+    for (nonpen_contact2D *contact : m_packed_contacts)
         if (contact->enabled()) [[likely]]
-            contact->on_pre_solve();
+        {
+            contact->startup(states);
+            m_contact_solver.add(contact);
+        }
 
-    for (constraint2D *constraint : m_constraints)
+    m_direct_solver.startup(states);
+    if (colored)
+        build_coloring(states.size());
+    else
+        build_kind_batches(direct);
+
+    // an island whose joints are all solved directly is exact after a single sweep
+    bool exact = false;
+    if (direct)
+    {
+        m_direct_solver.factorize();
+        const auto empty = [](const kind_batch &batch) { return batch.constraints.empty(); };
+        exact = m_contact_solver.empty() && std::all_of(m_kind_batches.begin(), m_kind_batches.end(), empty);
+    }
+
+    const std::uint32_t viters = exact ? std::min(1u, velocity_iteration_cap()) : velocity_iteration_cap();
+    m_velocity_iterations = 0;
+    m_velocity_residual = 0.f;
+    for (std::uint32_t i = 0; i < viters; i++)
+    {
+        m_velocity_residual = colored ? solve_colored_sweep() : solve_sweep();
+        m_velocity_iterations++;
+        if (params.adaptive_iterations && m_velocity_residual <= params.velocity_tolerance * largest_impulse())
+            break;
+    }
+    m_contact_solver.store_impulses();
+}
+
+// joints have no separate position bias, so they are just iterated once more
+void island2D::relax_velocity_constraints(const bool colored)
+{
+    m_contact_solver.use_bias(false);
+    if (colored)
+        solve_colored_sweep();
+    else
+        solve_sweep();
+    m_contact_solver.use_bias(true);
+    m_contact_solver.store_impulses();
+}
+
+// warm starting carries most of the work over from the previous stage, so small islands are capped by their size
+// instead of burning the whole iteration budget
+std::uint32_t island2D::velocity_iteration_cap() const
+{
+    const constraint_meta_manager2D &constraints = world.joints.constraints;
+    const std::uint32_t viters = constraints.velocity_iterations();
+    if (!constraints.params.adaptive_iterations)
+        return viters;
+    return std::min(viters, 1 + (std::uint32_t)std::bit_width(m_bodies.size()));
+}
+
+// the convergence residual is measured against the largest impulse the island holds, so that the tolerance does not
+// depend on the masses or units of the scene
+float island2D::largest_impulse() const
+{
+    float largest = m_contact_solver.largest_impulse();
+    for (const constraint2D *constraint : m_constraints)
         if (constraint->enabled()) [[likely]]
-            constraint->startup(states);
+            largest = std::max(largest, constraint->accumulated_impulse());
+    return largest;
+}
 
-    for (std::size_t i = 0; i < viters; i++)
-        for (constraint2D *constraint : m_constraints)
-            if (constraint->enabled()) [[likely]]
-                constraint->solve_velocities();
+float island2D::solve_sweep()
+{
+    float residual = 0.f;
+    for (const kind_batch &batch : m_kind_batches)
+        residual = std::max(residual, solve_kind_batch(batch));
+    residual = std::max(residual, m_contact_solver.solve_velocities());
+
+    // joints solved directly go last so that they end every sweep exactly satisfied
+    return std::max(residual, m_direct_solver.solve_velocities());
+}
+
+// the relative order of the constraints of each type is kept, so every batch is still solved Gauss-Seidel. batches of
+// types no longer present stay around empty, keeping their storage for the next stage. constraints the direct solver
+// accepts are left out
+void island2D::build_kind_batches(const bool direct)
+{
+    for (kind_batch &batch : m_kind_batches)
+        batch.constraints.clear();
+
+    for (constraint2D *constraint : m_constraints)
+    {
+        if (!constraint->enabled()) [[unlikely]]
+            continue;
+        if (direct && m_direct_solver.add(constraint))
+            continue;
+        const constraint_kind2D *kind = constraint->kind();
+        kind_batch *target = nullptr;
+        for (kind_batch &batch : m_kind_batches)
+            if (batch.kind == kind)
+            {
+                target = &batch;
+                break;
+            }
+        if (!target) [[unlikely]]
+            target = &m_kind_batches.emplace_back(kind_batch{kind, {}});
+        target->constraints.push_back(constraint);
+    }
+}
+
+float island2D::solve_kind_batch(const kind_batch &batch)
+{
+    if (batch.kind) [[likely]]
+        return batch.kind->solve_velocities(batch.constraints.data(), batch.constraints.size());
+
+    float residual = 0.f;
+    for (constraint2D *constraint : batch.constraints)
+    {
+        constraint->solve_velocities();
+        residual = std::max(residual, constraint->impulse_delta());
+    }
+    return residual;
+}
+
+// items below m_constraints.size() are joints, the rest are contact solver units
+void island2D::build_coloring(const std::size_t body_count)
+{
+    KIT_PERF_SCOPE("ppx::island2D::build_coloring")
+    m_coloring.begin(body_count);
+    for (std::size_t i = 0; i < m_constraints.size(); i++)
+    {
+        const constraint2D *constraint = m_constraints[i];
+        if (!constraint->enabled()) [[unlikely]]
+            continue;
+        const body2D *body1 = constraint->body1();
+        const body2D *body2 = constraint->body2();
+        m_coloring.add(i, body1->meta.index, body2->meta.index, body1->is_dynamic(), body2->is_dynamic());
+    }
+    const std::size_t offset = m_constraints.size();
+    for (std::size_t i = 0; i < m_contact_solver.unit_count(); i++)
+        m_coloring.add(offset + i, m_contact_solver.unit_index1(i), m_contact_solver.unit_index2(i),
+                       m_contact_solver.unit_dynamic1(i), m_contact_solver.unit_dynamic2(i));
+
+    const std::vector<std::vector<std::size_t>> &colors = m_coloring.colors();
+    m_color_batches.resize(colors.size());
+    for (std::size_t i = 0; i < colors.size(); i++)
+    {
+        color_batch &batch = m_color_batches[i];
+        batch.joints.clear();
+        batch.units.clear();
+        batch.tasks.clear();
+        for (const std::size_t item : colors[i])
+            if (item < offset)
+                batch.joints.push_back(item);
+            else
+                batch.units.push_back(item - offset);
+
+        for (std::size_t j = 0; j < batch.joints.size(); j++)
+            batch.tasks.push_back(j);
+        for (std::size_t j = 0; j < batch.units.size(); j += UNITS_PER_TASK)
+            batch.tasks.push_back(batch.joints.size() + j);
+        batch.residuals.resize(batch.tasks.size());
+    }
+}
+
+float island2D::solve_colored_item(const std::size_t item)
+{
+    if (item >= m_constraints.size())
+        return m_contact_solver.solve_unit(item - m_constraints.size());
+    constraint2D *constraint = m_constraints[item];
+    constraint->solve_velocities();
+    return constraint->impulse_delta();
+}
+
+// every task writes its residual to its own slot, so that no synchronization is needed
+void island2D::solve_color_task(color_batch &batch, const std::size_t task)
+{
+    const std::size_t joints = batch.joints.size();
+    if (task < joints)
+    {
+        batch.residuals[task] = solve_colored_item(batch.joints[task]);
+        return;
+    }
+    const std::size_t start = task - joints;
+    batch.residuals[joints + start / UNITS_PER_TASK] =
+        m_contact_solver.solve_units(batch.units.data() + start, std::min(UNITS_PER_TASK, batch.units.size() - start));
+}
+
+float island2D::solve_colored_sweep()
+{
+    KIT_PERF_SCOPE("ppx::island2D::solve_colored_sweep")
+    // tiny colors are not worth waking the pool for
+    constexpr std::size_t min_parallel_color = 64;
+
+    const auto pool = world.thread_pool;
+    float residual = 0.f;
+    for (color_batch &batch : m_color_batches)
+        if (batch.joints.size() + batch.units.size() >= min_parallel_color)
+        {
+            const auto lambda = [this, &batch](const std::size_t task) { solve_color_task(batch, task); };
+            kit::mt::for_each(*pool, batch.tasks.begin(), batch.tasks.end(), lambda, pool->thread_count());
+            for (const float task_residual : batch.residuals)
+                residual = std::max(residual, task_residual);
+        }
+        else
+        {
+            for (const std::size_t joint : batch.joints)
+                residual = std::max(residual, solve_colored_item(joint));
+            residual = std::max(residual, m_contact_solver.solve_units(batch.units.data(), batch.units.size()));
+        }
+
+    for (const std::size_t item : m_coloring.overflow())
+        residual = std::max(residual, solve_colored_item(item));
+    return residual;
 }
 
-void island2D::solve_position_constraints(std::vector<state2D> &states)
+void island2D::solve_position_constraints()
 {
-    const std::size_t piters = world.joints.constraints.params.position_iterations;
+    const std::size_t piters = world.joints.constraints.position_iterations();
     m_solved_positions = true;
     for (std::size_t i = 0; i < piters; i++)
     {
@@ -226,21 +546,19 @@ void island2D::solve_position_constraints(std::vector<state2D> &states)
         for (constraint2D *constraint : m_constraints)
             if (constraint->enabled()) [[likely]]
                 m_solved_positions &= constraint->solve_positions();
+        for (nonpen_contact2D *contact : m_contact_solver.contacts())
+            m_solved_positions &= contact->solve_positions();
         if (m_solved_positions)
             break;
     }
-    for (contact2D *contact : m_contacts)
-        contact->on_post_solve();
-
     if (!world.islands.params.enable_sleep)
         return;
 
-    m_energy = 0.f;
-    for (body2D *body : m_bodies)
-        m_energy += states[body->meta.index].kinetic_energy();
-    m_energy /= m_bodies.size();
+    const island_manager2D::motion2D &motion = world.islands.m_motion[m_awake_index];
+    m_energy = motion.energy_bodies != 0 ? motion.energy / (float)motion.energy_bodies : 0.f;
+    m_max_speed = glm::sqrt(motion.max_speed2);
 
-    if (m_energy < world.islands.sleep_energy_threshold(this))
+    if (m_energy < world.islands.sleep_energy_threshold(this) && motion.restless_bodies == 0)
     {
         m_time_still += world.substep_timestep();
         m_asleep = m_solved_positions && m_time_still >= world.islands.params.sleep_time_threshold;
@@ -259,18 +577,27 @@ bool island2D::no_bodies() const
 }
 bool island2D::no_joints() const
 {
-    return m_actuators.empty() && m_constraints.empty();
+    return m_actuators.empty() && m_constraints.empty() && m_contacts.empty();
 }
 
 std::size_t island2D::size() const
 {
-    return m_bodies.size() + m_actuators.size() + m_constraints.size();
+    return m_bodies.size() + m_actuators.size() + m_constraints.size() + m_packed_contacts.size();
+}
+std::size_t island2D::estimated_cost() const
+{
+    const std::size_t iterations = std::max(m_velocity_iterations, 1u);
+    return m_bodies.size() + m_actuators.size() + iterations * (m_constraints.size() + m_packed_contacts.size());
 }
 
 float island2D::time_still() const
 {
     return m_time_still;
 }
+float island2D::max_speed() const
+{
+    return m_max_speed;
+}
 float island2D::energy() const
 {
     return m_energy;
@@ -279,6 +606,14 @@ bool island2D::solved_positions() const
 {
     return m_solved_positions;
 }
+std::uint32_t island2D::velocity_iterations() const
+{
+    return m_velocity_iterations;
+}
+float island2D::velocity_residual() const
+{
+    return m_velocity_residual;
+}
 
 island2D *island2D::handle_island_merge_encounter(island2D *island1, island2D *island2)
 {
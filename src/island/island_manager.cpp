@@ -2,45 +2,101 @@
 #include "ppx/island/island_manager.hpp"
 #include "ppx/world.hpp"
 #include "kit/multithreading/mt_for_each.hpp"
+#include <atomic>
 
 namespace ppx
 {
+// islands are handed out largest first from a shared cursor, so that threads that finish early keep taking work
+// instead of waiting on a fixed chunk of islands
+template <typename Pass> void island_manager2D::run_scheduled(Pass &&pass)
+{
+    const auto pool = world.thread_pool;
+    if (!params.multithreading || !pool || m_tasks.size() < 2)
+    {
+        for (island2D *island : m_awake_islands)
+            pass(island);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    const auto worker = [this, &pass, &next](std::size_t) {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < m_tasks.size();
+             i = next.fetch_add(1, std::memory_order_relaxed))
+            for (std::size_t j = m_tasks[i].begin; j < m_tasks[i].end; j++)
+                pass(m_awake_islands[j]);
+    };
+    m_workers.resize(std::min(pool->thread_count(), m_tasks.size()));
+    kit::mt::for_each(*pool, m_workers.begin(), m_workers.end(), worker, m_workers.size());
+}
+
 void island_manager2D::solve_actuators(std::vector<state2D> &states)
 {
     KIT_PERF_SCOPE("ppx::island_manager2D::solve_actuators")
-    const auto lambda = [&states](island2D *island) { island->solve_actuators(states); };
+    run_scheduled([&states](island2D *island) { island->solve_actuators(states); });
+}
+
+// colored islands use the pool themselves, so they must not run inside a pool task
+template <typename Pass> void island_manager2D::run_velocity_pass(Pass &&pass)
+{
     const auto pool = world.thread_pool;
     if (params.multithreading && pool)
-        kit::mt::for_each(*pool, m_awake_islands.begin(), m_awake_islands.end(), lambda, pool->thread_count());
+    {
+        run_scheduled([&pass](island2D *island) {
+            if (!island->m_colored)
+                pass(island, false);
+        });
+        for (island2D *island : m_awake_islands)
+            if (island->m_colored)
+                pass(island, true);
+    }
     else
         for (island2D *island : m_awake_islands)
-            lambda(island);
+            pass(island, false);
 }
 
 void island_manager2D::solve_velocity_constraints(std::vector<state2D> &states)
 {
     KIT_PERF_SCOPE("ppx::island_manager2D::solve_velocity_constraints")
+    run_velocity_pass(
+        [&states](island2D *island, const bool colored) { island->solve_velocity_constraints(states, colored); });
+}
 
-    const auto lambda = [&states](island2D *island) { island->solve_velocity_constraints(states); };
-    const auto pool = world.thread_pool;
-    if (params.multithreading && pool) // use thread pool directly or mt::for_each? test it!
-        kit::mt::for_each(*pool, m_awake_islands.begin(), m_awake_islands.end(), lambda, pool->thread_count());
-    else
-        for (island2D *island : m_awake_islands)
-            lambda(island);
+void island_manager2D::relax_velocity_constraints()
+{
+    KIT_PERF_SCOPE("ppx::island_manager2D::relax_velocity_constraints")
+    run_velocity_pass([](island2D *island, const bool colored) { island->relax_velocity_constraints(colored); });
 }
 
-void island_manager2D::solve_position_constraints(std::vector<state2D> &states)
+void island_manager2D::solve_position_constraints()
 {
     KIT_PERF_SCOPE("ppx::island_manager2D::solve_position_constraints")
+    run_scheduled([](island2D *island) { island->solve_position_constraints(); });
+}
 
-    const auto lambda = [&states](island2D *island) { island->solve_position_constraints(states); };
-    const auto pool = world.thread_pool;
-    if (params.multithreading && pool) // use thread pool directly or mt::for_each? test it!
-        kit::mt::for_each(*pool, m_awake_islands.begin(), m_awake_islands.end(), lambda, pool->thread_count());
-    else
-        for (island2D *island : m_awake_islands)
-            lambda(island);
+// colored islands are solved outside of the schedule, but still get a task of their own for the other passes
+void island_manager2D::build_schedule()
+{
+    KIT_PERF_SCOPE("ppx::island_manager2D::build_schedule")
+    m_costs.resize(m_awake_islands.size());
+    for (std::size_t i = 0; i < m_awake_islands.size(); i++)
+        m_costs[i] = {m_awake_islands[i]->estimated_cost(), m_awake_islands[i]};
+    std::sort(m_costs.begin(), m_costs.end(), [](const auto &c1, const auto &c2) { return c1.first > c2.first; });
+
+    m_tasks.clear();
+    std::size_t batch_cost = 0;
+    for (std::size_t i = 0; i < m_costs.size(); i++)
+    {
+        island2D *island = m_costs[i].second;
+        m_awake_islands[i] = island;
+        if (batch_cost == 0 || island->m_colored)
+            m_tasks.push_back({i, i + 1});
+        else
+            m_tasks.back().end = i + 1;
+
+        batch_cost = island->m_colored ? 0 : batch_cost + m_costs[i].first;
+        if (batch_cost >= MIN_TASK_COST)
+            batch_cost = 0;
+    }
 }
 
 void island_manager2D::remove_invalid_and_gather_awake()
@@ -57,11 +113,45 @@ void island_manager2D::remove_invalid_and_gather_awake()
         }
         else
         {
+            island->m_awake_index = SIZE_MAX;
+            island->m_colored = params.multithreading && world.thread_pool &&
+                                island->m_bodies.size() >= params.coloring_body_threshold;
             if (!island->asleep())
                 m_awake_islands.push_back(island);
             ++it;
         }
     }
+    build_schedule();
+    for (std::size_t i = 0; i < m_awake_islands.size(); i++)
+        m_awake_islands[i]->m_awake_index = i;
+    m_motion.assign(m_awake_islands.size(), motion2D{});
+}
+
+void island_manager2D::record_motion(const body2D *body, const state2D &state)
+{
+    const island2D *island = body->meta.island;
+    if (!island || island->m_awake_index == SIZE_MAX)
+        return;
+    motion2D &motion = m_motion[island->m_awake_index];
+    const float speed2 = glm::length2(state.velocity);
+    motion.max_speed2 = std::max(motion.max_speed2, speed2);
+
+    const float threshold = body->sleep_velocity_threshold();
+    if (threshold <= 0.f)
+    {
+        motion.energy += state.kinetic_energy();
+        motion.energy_bodies++;
+        return;
+    }
+
+    // without an angular threshold, the angular velocity is turned into the speed at the radius of gyration
+    const float angular_threshold = body->sleep_angular_velocity_threshold();
+    const float angular_speed2 = state.angular_velocity * state.angular_velocity;
+    const bool spinning = angular_threshold > 0.f
+                              ? angular_speed2 > angular_threshold * angular_threshold
+                              : angular_speed2 * state.inertia > threshold * threshold * state.mass;
+    if (speed2 > threshold * threshold || spinning)
+        motion.restless_bodies++;
 }
 
 bool island_manager2D::all_asleep() const
@@ -106,16 +196,31 @@ island2D *island_manager2D::create_and_add()
 {
     island2D *island = allocator<island2D>::create(world);
     m_elements.push_back(island);
+    m_layout_changed = true;
     return island;
 }
 
-island2D *island_manager2D::create_island_from_body(body2D *body)
+bool island_manager2D::reorder_due()
+{
+    if (!m_layout_changed || params.reorder_interval == 0 || world.step_count() % params.reorder_interval != 0)
+        return false;
+    m_layout_changed = false;
+    return true;
+}
+void island_manager2D::sort_by_bodies()
+{
+    for (island2D *island : m_elements)
+        if (!island->m_merged)
+            island->sort_by_bodies();
+}
+
+island2D *island_manager2D::create_island_from_body(body2D *body, const std::uint32_t epoch)
 {
     KIT_PERF_SCOPE("ppx::island_manager2D::create_island_from_body")
-    if (body->meta.island_flag || !body->is_dynamic())
+    if (body->meta.island_epoch == epoch || !body->is_dynamic())
         return nullptr;
     island2D *island = allocator<island2D>::create(world);
-    body->meta.island_flag = true;
+    body->meta.island_epoch = epoch;
 
     std::stack<body2D *> stack;
     stack.push(body);
@@ -125,31 +230,39 @@ island2D *island_manager2D::create_island_from_body(body2D *body)
         stack.pop();
         island->add_body(current);
 
-        const auto process_joint = [current, island, &stack](joint2D *joint) {
-            if (joint->meta.island_flag)
-                return;
-            joint->meta.island_flag = true;
-
-            if (joint->is_constraint())
-                island->m_constraints.push_back(dynamic_cast<constraint2D *>(joint));
-            else
-                island->m_actuators.push_back(dynamic_cast<actuator2D *>(joint));
+        const auto process_joint = [current, epoch, &stack](joint2D *joint) {
+            if (joint->meta.island_epoch == epoch)
+                return false;
+            joint->meta.island_epoch = epoch;
 
             body2D *other = joint->other(current);
-            if (!other->meta.island_flag && other->is_dynamic())
+            if (other->meta.island_epoch != epoch && other->is_dynamic())
             {
-                other->meta.island_flag = true;
+                other->meta.island_epoch = epoch;
                 stack.push(other);
             }
+            return true;
         };
         for (joint2D *joint : current->meta.joints)
-            process_joint(joint);
+            if (process_joint(joint))
+            {
+                if (joint->is_constraint())
+                    island2D::push_back(island->m_constraints, dynamic_cast<constraint2D *>(joint),
+                                        &joint2D::metadata::island_slot);
+                else
+                    island2D::push_back(island->m_actuators, dynamic_cast<actuator2D *>(joint),
+                                        &joint2D::metadata::island_slot);
+            }
         for (contact2D *contact : current->meta.contacts)
-        {
-            if (!contact->meta.island_flag)
-                island->m_contacts.push_back(contact);
-            process_joint(contact);
-        }
+            if (process_joint(contact))
+            {
+                island2D::push_back(island->m_contacts, contact, &joint2D::metadata::island_contact_slot);
+                if (auto packed = dynamic_cast<nonpen_contact2D *>(contact))
+                    island2D::push_back(island->m_packed_contacts, packed, &joint2D::metadata::island_slot);
+                else if (contact->is_constraint())
+                    island2D::push_back(island->m_constraints, dynamic_cast<constraint2D *>(contact),
+                                        &joint2D::metadata::island_slot);
+            }
     }
     return island;
 }
@@ -164,83 +277,104 @@ bool island_manager2D::remove(const std::size_t index)
     return true;
 }
 
+// a fresh epoch marks everything as unvisited without touching it
 void island_manager2D::build_from_existing_simulation()
 {
-    for (body2D *body : world.bodies)
-        body->meta.island_flag = false;
-    for (joint2D *joint : world.joints)
-        joint->meta.island_flag = false;
-    for (contact2D *contact : world.collisions.contact_manager()->create_total_contacts_list())
-        contact->meta.island_flag = false;
-
+    const std::uint32_t epoch = ++m_epoch;
+    m_layout_changed = true;
     for (body2D *body : world.bodies)
     {
-        island2D *island = create_island_from_body(body);
+        island2D *island = create_island_from_body(body, epoch);
         if (island)
             m_elements.push_back(island);
     }
 }
 
-void island_manager2D::try_split()
+// every island that lost a joint or a contact is checked in the same step. the connected components are found in
+// parallel, the new islands are committed serially, and the islands that came apart are then rebuilt in parallel
+void island_manager2D::split_islands()
 {
-    KIT_PERF_SCOPE("ppx::island_manager2D::try_split")
-
-    std::size_t iter = 0;
-    m_remove_index = glm::min(m_remove_index, m_elements.size());
-    while (iter++ < m_elements.size())
-    {
-        if (m_remove_index-- == 0)
-            m_remove_index = m_elements.size() - 1;
-
-        island2D *island = m_elements[m_remove_index];
+    KIT_PERF_SCOPE("ppx::island_manager2D::split_islands")
+    m_split_candidates.clear();
+    for (island2D *island : m_elements)
         if (island->evaluate_split_candidate())
+            m_split_candidates.push_back(island);
+    if (m_split_candidates.empty())
+        return;
+
+    const auto pool = world.thread_pool;
+    const auto for_each_island = [this, &pool](std::vector<island2D *> &islands, const auto &lambda) {
+        if (params.multithreading && pool && islands.size() > 1)
+            kit::mt::for_each(*pool, islands.begin(), islands.end(), lambda, pool->thread_count());
+        else
+            for (island2D *island : islands)
+                lambda(island);
+    };
+    for_each_island(m_split_candidates, [](island2D *island) { island->find_components(); });
+
+    std::size_t splits = 0;
+    for (island2D *island : m_split_candidates)
+        if (island->m_component_count > 1)
         {
-            if (split(island))
-            {
-                m_elements.erase(m_elements.begin() + m_remove_index);
-                allocator<island2D>::destroy(island);
-            }
-            return;
+            create_split_targets(island);
+            m_split_candidates[splits++] = island;
         }
-    }
+    m_split_candidates.resize(splits);
+    for_each_island(m_split_candidates, [](island2D *island) { split(island); });
 }
 
-bool island_manager2D::split(island2D *island)
+// the first component stays in the original island so that its address does not change
+void island_manager2D::create_split_targets(island2D *island)
 {
-    KIT_PERF_SCOPE("ppx::island_manager2D::split")
-    const bool was_asleep = island->asleep();
-    const float time_still = island->time_still();
-
-    for (body2D *body : island->m_bodies)
+    island->m_split_targets.assign(island->m_component_count, island);
+    for (std::size_t i = 1; i < island->m_split_targets.size(); i++)
     {
-        KIT_ASSERT_ERROR(body->is_dynamic(), "Body must be dynamic");
-        body->meta.island_flag = false;
+        island2D *target = create_and_add();
+        target->m_asleep = island->m_asleep;
+        target->m_time_still = island->m_time_still;
+        island->m_split_targets[i] = target;
     }
-    for (joint2D *joint : island->m_actuators)
-        joint->meta.island_flag = false;
-    for (constraint2D *constraint : island->m_constraints)
-        constraint->meta.island_flag = false;
+}
 
-    for (body2D *body : island->m_bodies)
+// only touches the island, its targets and their elements, so different islands can be split in parallel
+void island_manager2D::split(island2D *island)
+{
+    KIT_PERF_SCOPE("ppx::island_manager2D::split")
+    const std::vector<island2D *> &targets = island->m_split_targets;
+
+    // joints go first, as their component is looked up through the island slots of their bodies
+    const std::vector<actuator2D *> actuators = std::move(island->m_actuators);
+    const std::vector<constraint2D *> constraints = std::move(island->m_constraints);
+    const std::vector<contact2D *> contacts = std::move(island->m_contacts);
+    const std::vector<nonpen_contact2D *> packed_contacts = std::move(island->m_packed_contacts);
+    island->m_actuators.clear();
+    island->m_constraints.clear();
+    island->m_contacts.clear();
+    island->m_packed_contacts.clear();
+
+    for (actuator2D *actuator : actuators)
+        island2D::push_back(targets[island->component_of(actuator)]->m_actuators, actuator,
+                            &joint2D::metadata::island_slot);
+    for (constraint2D *constraint : constraints)
+        island2D::push_back(targets[island->component_of(constraint)]->m_constraints, constraint,
+                            &joint2D::metadata::island_slot);
+    for (contact2D *contact : contacts)
+        island2D::push_back(targets[island->component_of(contact)]->m_contacts, contact,
+                            &joint2D::metadata::island_contact_slot);
+    for (nonpen_contact2D *contact : packed_contacts)
+        island2D::push_back(targets[island->component_of(contact)]->m_packed_contacts, contact,
+                            &joint2D::metadata::island_slot);
+
+    const std::vector<body2D *> bodies = std::move(island->m_bodies);
+    island->m_bodies.clear();
+    for (std::size_t i = 0; i < bodies.size(); i++)
     {
-        island2D *new_island = create_island_from_body(body);
-        if (!new_island)
-            continue;
-
-        if (new_island->m_bodies.size() == island->m_bodies.size())
-        {
-            // i could just swap the islands, but it messes up their adresses and its annoying
-            for (body2D *b : island->m_bodies)
-                b->meta.island = island;
-            allocator<island2D>::destroy(new_island);
-            return false;
-        }
-        new_island->m_asleep = was_asleep;
-        new_island->m_time_still = time_still;
-        m_elements.push_back(new_island);
+        island2D *target = targets[island->m_components[i]];
+        island2D::push_back(target->m_bodies, bodies[i], &body2D::metadata::island_slot);
+        bodies[i]->meta.island = target;
     }
-
-    return true;
+    island->m_component_count = 1;
+    island->m_split_targets.clear();
 }
 
 bool island_manager2D::checksum() const
@@ -267,16 +401,11 @@ bool island_manager2D::checksum() const
             return false;
         }
         body_count += island->m_bodies.size();
-        for (actuator2D *actuator : island->m_actuators)
-            if (dynamic_cast<contact2D *>(actuator))
-                contact_count++;
-            else
-                joint_count++;
+        joint_count += island->m_actuators.size();
         for (constraint2D *constraint : island->m_constraints)
-            if (dynamic_cast<contact2D *>(constraint))
-                contact_count++;
-            else
+            if (!dynamic_cast<contact2D *>(constraint))
                 joint_count++;
+        contact_count += island->m_contacts.size();
     }
 
     const std::unordered_set<const island2D *> islands(m_elements.begin(), m_elements.end());
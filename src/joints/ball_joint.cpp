@@ -34,14 +34,14 @@ float ball_joint2D::constraint_velocity() const
 
 bool ball_joint2D::solve_positions()
 {
-    if (m_legal_angle)
+    if (m_legal_angle || m_position_based)
         return true;
     return pvconstraint2D<0, 1>::solve_positions();
 }
 
 void ball_joint2D::solve_velocities()
 {
-    if (m_legal_angle)
+    if (m_legal_angle || m_position_based)
         return;
     if (kit::approximately(m_min_angle, m_max_angle))
         pvconstraint2D<0, 1>::solve_velocities();
@@ -40,14 +40,14 @@ glm::vec2 distance_joint2D::direction() const
 
 bool distance_joint2D::solve_positions()
 {
-    if (m_legal_length)
+    if (m_legal_length || m_position_based)
         return true;
     return pvconstraint2D<1, 0>::solve_positions();
 }
 
 void distance_joint2D::solve_velocities()
 {
-    if (m_legal_length)
+    if (m_legal_length || m_position_based)
         return;
     if (kit::approximately(m_min_distance, m_max_distance))
         pvconstraint2D<1, 0>::solve_velocities();
@@ -108,4 +108,10 @@ void distance_joint2D::update_constraint_data()
     m_legal_length = m_length >= m_min_distance && m_length <= m_max_distance;
     m_c = constraint_position();
 }
+
+// a distance range acts as an inequality, so only fixed distances are equalities
+bool distance_joint2D::is_equality() const
+{
+    return kit::approximately(m_min_distance, m_max_distance);
+}
 } // namespace ppx
\ No newline at end of file
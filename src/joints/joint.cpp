@@ -27,7 +27,8 @@ joint2D::joint2D(world2D &world, const specs::joint2D &spc, const specs::joint2D
 joint2D::joint2D(world2D &world, body2D *body1, body2D *body2, const glm::vec2 &ganchor1, const glm::vec2 &ganchor2,
                  const specs::joint2D::properties &jprops)
     : worldref2D(world), m_body1(body1), m_body2(body2), m_lanchor1(body1->state().local_position_point(ganchor1)),
-      m_lanchor2(body2->state().local_position_point(ganchor2)), m_bodies_collide(jprops.bodies_collide)
+      m_lanchor2(body2->state().local_position_point(ganchor2)), m_bodies_collide(jprops.bodies_collide),
+      m_position_based(jprops.position_based)
 {
     KIT_ASSERT_ERROR(body1 != body2, "Cannot create joint between the same body: {0}", body1->meta.index);
 }
@@ -40,7 +41,7 @@ joint2D::joint2D(world2D &world, body2D *body1, body2D *body2, const glm::vec2 &
 
 joint2D::joint2D(world2D &world, body2D *body1, body2D *body2, const specs::joint2D::properties &jprops)
     : worldref2D(world), m_body1(body1), m_body2(body2), m_lanchor1(0.f), m_lanchor2(0.f),
-      m_bodies_collide(jprops.bodies_collide)
+      m_bodies_collide(jprops.bodies_collide), m_position_based(jprops.position_based)
 {
 }
 
@@ -113,19 +114,31 @@ void joint2D::bodies_collide(const bool bodies_collide)
     awake();
 }
 
+bool joint2D::position_based() const
+{
+    return m_position_based;
+}
+void joint2D::position_based(const bool position_based)
+{
+    m_position_based = position_based;
+    awake();
+}
+
 specs::joint2D::properties joint2D::jprops() const
 {
-    return {m_bodies_collide};
+    return {m_bodies_collide, m_position_based};
 }
 void joint2D::jprops(const specs::joint2D::properties &jprops)
 {
     m_bodies_collide = jprops.bodies_collide;
+    m_position_based = jprops.position_based;
     awake();
 }
 
 void joint2D::fill_jprops(specs::joint2D::properties &jprops) const
 {
     jprops.bodies_collide = m_bodies_collide;
+    jprops.position_based = m_position_based;
 }
 
 bool joint2D::is_constraint() const
@@ -152,8 +165,8 @@ void joint2D::compute_anchors_and_offsets(const state2D &state1, const state2D &
 
 void joint2D::add_to_bodies()
 {
-    m_body1->meta.joints.push_back(this);
-    m_body2->meta.joints.push_back(this);
+    m_body1->meta.add_joint(this);
+    m_body2->meta.add_joint(this);
 }
 
 void joint2D::remove_from_bodies()
@@ -30,6 +30,7 @@ void motor_joint2D::solve_velocities()
         m_cumimpulse = glm::normalize(m_cumimpulse) * max_impulse;
 
     const glm::vec2 delta_impulse = m_cumimpulse - old_impulse;
+    m_impulse_delta = glm::length(delta_impulse);
     if (!kit::approaches_zero(glm::length2(delta_impulse)))
         apply_linear_impulse(delta_impulse);
 }
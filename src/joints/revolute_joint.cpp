@@ -28,4 +28,9 @@ void revolute_joint2D::props(const specs::properties &props)
     cprops(props);
 }
 
+bool revolute_joint2D::is_equality() const
+{
+    return true;
+}
+
 } // namespace ppx
\ No newline at end of file
@@ -9,7 +9,7 @@
 namespace ppx
 {
 spring_joint2D::spring_joint2D(world2D &world, const specs &spc)
-    : joint2D(world, spc, spc.ganchor1, spc.ganchor2), m_frequency(spc.props.frequency),
+    : joint2D(world, spc, spc.ganchor1, spc.ganchor2, spc.props), m_frequency(spc.props.frequency),
       m_damping_ratio(spc.props.damping_ratio), m_min_length(spc.props.min_length), m_max_length(spc.props.max_length),
       m_non_linear_terms(spc.props.non_linear_terms), m_non_linear_contribution(spc.props.non_linear_contribution)
 {
@@ -37,6 +37,8 @@ glm::vec2 spring_joint2D::non_linear_displacement(const glm::vec2 &displacement)
 
 glm::vec3 spring_joint2D::compute_force(const state2D &state1, const state2D &state2) const
 {
+    if (m_position_based)
+        return glm::vec3(0.f);
     const glm::vec2 relpos = m_ganchor2 - m_ganchor1;
     const float length = glm::length(relpos);
     if (length >= m_min_length && length <= m_max_length)
@@ -36,4 +36,9 @@ void weld_joint2D::props(const specs::properties &props)
     cprops(props);
 }
 
+bool weld_joint2D::is_equality() const
+{
+    return true;
+}
+
 } // namespace ppx
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "ppx/internal/pch.hpp"
+#include "ppx/joints/xpbd_solver.hpp"
+#include "ppx/joints/spring_joint.hpp"
+#include "ppx/joints/distance_joint.hpp"
+#include "ppx/joints/ball_joint.hpp"
+#include "ppx/world.hpp"
+#include "kit/multithreading/mt_for_each.hpp"
+#include "kit/utility/utils.hpp"
+
+namespace ppx
+{
+void xpbd_solver2D::solve(std::vector<state2D> &states, const float timestep)
+{
+    KIT_PERF_SCOPE("ppx::xpbd_solver2D::solve")
+    if (world.step_count() != m_gather_step)
+        gather(states);
+    if (m_rows.empty())
+        return;
+
+    for (row &rw : m_rows)
+        rw.lambda = 0.f;
+
+    // tiny colors are not worth waking the pool for
+    constexpr std::size_t min_parallel_color = 64;
+    const auto pool = world.thread_pool;
+    const bool mt = params.multithreading && pool;
+    const auto lambda = [this, &states, timestep](const std::size_t index) {
+        project(m_rows[index], states, timestep);
+    };
+    for (std::uint32_t i = 0; i < params.iterations; i++)
+    {
+        for (const std::vector<std::size_t> &color : m_coloring.colors())
+            if (mt && color.size() >= min_parallel_color)
+                kit::mt::for_each(*pool, color.begin(), color.end(), lambda, pool->thread_count());
+            else
+                for (const std::size_t index : color)
+                    lambda(index);
+        for (const std::size_t index : m_coloring.overflow())
+            lambda(index);
+    }
+}
+
+void xpbd_solver2D::gather(const std::vector<state2D> &states)
+{
+    m_gather_step = world.step_count();
+    m_rows.clear();
+
+    row rw;
+    if (const auto springs = world.joints.manager<spring_joint2D>())
+        for (const spring_joint2D *spring : *springs)
+            if (fill_row(rw, spring, states, spring->min_length(), spring->max_length(), spring->frequency(),
+                         spring->damping_ratio(), false))
+                m_rows.push_back(rw);
+
+    // hard constraints have no compliance
+    if (const auto distance_joints = world.joints.manager<distance_joint2D>())
+        for (const distance_joint2D *dj : *distance_joints)
+            if (fill_row(rw, dj, states, dj->min_distance(), dj->max_distance(), dj->is_soft() ? dj->frequency() : 0.f,
+                         dj->damping_ratio(), false))
+                m_rows.push_back(rw);
+
+    if (const auto ball_joints = world.joints.manager<ball_joint2D>())
+        for (const ball_joint2D *bj : *ball_joints)
+            if (fill_row(rw, bj, states, bj->min_angle(), bj->max_angle(), bj->is_soft() ? bj->frequency() : 0.f,
+                         bj->damping_ratio(), true))
+                m_rows.push_back(rw);
+
+    m_coloring.begin(states.size());
+    for (std::size_t i = 0; i < m_rows.size(); i++)
+    {
+        const row &r = m_rows[i];
+        m_coloring.add(i, r.index1, r.index2, states[r.index1].is_dynamic(), states[r.index2].is_dynamic());
+    }
+}
+
+// a frequency of zero means a hard joint, except for springs, which then do nothing
+bool xpbd_solver2D::fill_row(row &rw, const joint2D *joint, const std::vector<state2D> &states, const float min,
+                             const float max, const float frequency, const float damping_ratio,
+                             const bool angular) const
+{
+    if (!joint->position_based() || !joint->enabled() || joint->asleep())
+        return false;
+    if (joint->is_actuator() && kit::approaches_zero(frequency))
+        return false;
+
+    rw.index1 = joint->body1()->meta.index;
+    rw.index2 = joint->body2()->meta.index;
+    const state2D &st1 = states[rw.index1];
+    const state2D &st2 = states[rw.index2];
+
+    rw.dyn1 = st1.is_dynamic();
+    rw.dyn2 = st2.is_dynamic();
+    rw.imass1 = rw.dyn1 ? st1.inv_mass() : 0.f;
+    rw.imass2 = rw.dyn2 ? st2.inv_mass() : 0.f;
+    rw.iinertia1 = rw.dyn1 ? st1.inv_inertia() : 0.f;
+    rw.iinertia2 = rw.dyn2 ? st2.inv_inertia() : 0.f;
+
+    const float inv_mass = angular ? rw.iinertia1 + rw.iinertia2 : rw.imass1 + rw.imass2;
+    if (kit::approaches_zero(inv_mass))
+        return false;
+
+    rw.compliance = 0.f;
+    rw.damping = 0.f;
+    if (!kit::approaches_zero(frequency))
+    {
+        const auto [stiffness, damping] =
+            spring_joint2D::stiffness_and_damping(frequency, damping_ratio, 1.f / inv_mass);
+        rw.compliance = 1.f / stiffness;
+        rw.damping = damping;
+    }
+
+    rw.lanchor1 = joint->lanchor1();
+    rw.lanchor2 = joint->lanchor2();
+    rw.min = min;
+    rw.max = max;
+    rw.lambda = 0.f;
+    rw.angular = angular;
+    return true;
+}
+
+void xpbd_solver2D::project(row &rw, std::vector<state2D> &states, const float timestep) const
+{
+    state2D &st1 = states[rw.index1];
+    state2D &st2 = states[rw.index2];
+    if (rw.angular)
+        project_angle(rw, st1, st2, timestep);
+    else
+        project_distance(rw, st1, st2, timestep);
+}
+
+void xpbd_solver2D::project_distance(row &rw, state2D &state1, state2D &state2, const float timestep) const
+{
+    const glm::vec2 offset1 = state1.global_position_point(rw.lanchor1) - state1.centroid.position;
+    const glm::vec2 offset2 = state2.global_position_point(rw.lanchor2) - state2.centroid.position;
+    const glm::vec2 relpos = state2.centroid.position + offset2 - state1.centroid.position - offset1;
+
+    const float length = glm::length(relpos);
+    float c;
+    if (length < rw.min)
+        c = length - rw.min;
+    else if (length > rw.max)
+        c = length - rw.max;
+    else
+        return;
+
+    const glm::vec2 dir = !kit::approaches_zero(length) ? relpos / length : glm::vec2(1.f, 0.f);
+    const float cross1 = kit::cross2D(offset1, dir);
+    const float cross2 = kit::cross2D(offset2, dir);
+    const float inv_mass = rw.imass1 + rw.imass2 + rw.iinertia1 * cross1 * cross1 + rw.iinertia2 * cross2 * cross2;
+    const float cvel =
+        glm::dot(dir, state2.velocity_at_centroid_offset(offset2) - state1.velocity_at_centroid_offset(offset1));
+
+    const glm::vec2 correction = lambda_step(rw, c, cvel, inv_mass, timestep) * dir;
+    const float inv_ts = 1.f / timestep;
+    const glm::vec2 force = correction * inv_ts * inv_ts;
+
+    // velocities follow the displacement, and the equivalent force is reported for rk integration
+    if (rw.dyn1)
+    {
+        const glm::vec2 dpos1 = rw.imass1 * correction;
+        const float da1 = rw.iinertia1 * kit::cross2D(offset1, correction);
+        state1.centroid.position -= dpos1;
+        state1.centroid.rotation -= da1;
+        state1.velocity -= dpos1 * inv_ts;
+        state1.angular_velocity -= da1 * inv_ts;
+        state1.substep_force -= force;
+        state1.substep_torque -= kit::cross2D(offset1, force);
+    }
+    if (rw.dyn2)
+    {
+        const glm::vec2 dpos2 = rw.imass2 * correction;
+        const float da2 = rw.iinertia2 * kit::cross2D(offset2, correction);
+        state2.centroid.position += dpos2;
+        state2.centroid.rotation += da2;
+        state2.velocity += dpos2 * inv_ts;
+        state2.angular_velocity += da2 * inv_ts;
+        state2.substep_force += force;
+        state2.substep_torque += kit::cross2D(offset2, force);
+    }
+}
+
+// the angle is measured as in ball_joint2D: rotation of body 1 minus rotation of body 2
+void xpbd_solver2D::project_angle(row &rw, state2D &state1, state2D &state2, const float timestep) const
+{
+    float relangle = state1.centroid.rotation - state2.centroid.rotation;
+    relangle -= glm::round(relangle / glm::two_pi<float>()) * glm::two_pi<float>();
+
+    float c;
+    if (relangle < rw.min)
+        c = relangle - rw.min;
+    else if (relangle > rw.max)
+        c = relangle - rw.max;
+    else
+        return;
+
+    const float cvel = state1.angular_velocity - state2.angular_velocity;
+    const float correction = lambda_step(rw, c, cvel, rw.iinertia1 + rw.iinertia2, timestep);
+    const float inv_ts = 1.f / timestep;
+    const float torque = correction * inv_ts * inv_ts;
+
+    if (rw.dyn1)
+    {
+        const float da1 = rw.iinertia1 * correction;
+        state1.centroid.rotation += da1;
+        state1.angular_velocity += da1 * inv_ts;
+        state1.substep_torque += torque;
+    }
+    if (rw.dyn2)
+    {
+        const float da2 = rw.iinertia2 * correction;
+        state2.centroid.rotation -= da2;
+        state2.angular_velocity -= da2 * inv_ts;
+        state2.substep_torque -= torque;
+    }
+}
+
+// xpbd update of the lagrange multiplier with compliance and damping (see Macklin et al. 2016)
+float xpbd_solver2D::lambda_step(row &rw, const float c, const float cvel, const float inv_mass,
+                                 const float timestep) const
+{
+    const float alpha = rw.compliance / (timestep * timestep);
+    const float gamma = rw.compliance * rw.damping / timestep;
+    const float denominator = (1.f + gamma) * inv_mass + alpha;
+    if (kit::approaches_zero(denominator))
+        return 0.f;
+
+    const float dlambda = (-c - alpha * rw.lambda - gamma * cvel * timestep) / denominator;
+    rw.lambda += dlambda;
+    return dlambda;
+}
+
+std::size_t xpbd_solver2D::size() const
+{
+    return m_rows.size();
+}
+
+} // namespace ppx
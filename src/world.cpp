@@ -27,7 +27,9 @@ world2D::world2D(const specs::world2D &spc)
     bodies.params = spc.bodies;
     colliders.params = spc.colliders;
     joints.constraints.params = spc.joints.constraints;
+    joints.xpbd.params = spc.joints.xpbd;
     collisions.broad()->params = spc.collision.broad;
+    collisions.narrow()->params = spc.collision.narrow;
     collisions.contact_manager()->params = spc.collision.contacts;
     islands.params = spc.islands;
 }
@@ -61,7 +63,7 @@ bool world2D::step()
 
     m_step_count++;
     pre_step();
-    const bool valid = integrator.raw_forward(*this);
+    const bool valid = joints.constraints.params.soft_step ? soft_step() : integrator.raw_forward(*this);
     post_step();
     return valid;
 }
@@ -76,13 +78,15 @@ void world2D::pre_step()
 #if defined(DEBUG) && !defined(_MSC_VER) // little fix, seems feenableexcept does not exist on windows
     feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
 #endif
+    if (islands.enabled() && islands.reorder_due())
+        bodies.sort_by_island();
     bodies.gather_and_load_states(integrator.state);
 
     // surprisingly, i can get away with computing collisions once per step no matter the rk order
     if (collisions.enabled())
         collisions.detect_and_create_contacts();
     if (islands.enabled())
-        islands.try_split();
+        islands.split_islands();
 
     KIT_ASSERT_ERROR(collisions.contact_manager()->checksum(bodies), "Contacts checksum failed")
     KIT_ASSERT_ERROR(bodies.checksum(), "Bodies checksum failed")
@@ -102,12 +106,46 @@ std::vector<float> world2D::operator()(const float time, const float timestep, c
         bodies.update_states(posvels);
 
     std::vector<state2D> &states = bodies.mutable_states();
+    solve_substep(states, timestep);
+
+    m_rk_substep_index++;
+    return bodies.load_velocities_and_forces();
+}
+
+// collisions were computed once in pre_step. the integrator stages are skipped, states are advanced directly with
+// semi implicit euler and handed back to the integrator state so that post_step can retrieve them as usual. the
+// integrator itself is never stepped, so its own clock does not advance in this mode. the step is reported valid as
+// long as every resulting position and velocity is finite
+bool world2D::soft_step()
+{
+    KIT_PERF_SCOPE("ppx::world2D::soft_step")
+    const std::uint32_t substeps = std::max(joints.constraints.params.substeps, 1u);
+    const float timestep = integrator.ts.value / (float)substeps;
+    m_rk_timestep = timestep;
+
+    std::vector<state2D> &states = bodies.mutable_states();
+    for (std::uint32_t i = 0; i < substeps; i++)
+    {
+        if (i != 0)
+            bodies.reset_substep_forces();
+        solve_substep(states, timestep);
+        m_rk_substep_index++;
+    }
+    bodies.load_states(integrator.state);
+
+    const std::vector<float> &vars = integrator.state.vars();
+    return std::all_of(vars.begin(), vars.end(), [](const float var) { return std::isfinite(var); });
+}
+
+void world2D::solve_substep(std::vector<state2D> &states, const float timestep)
+{
     behaviours.load_forces(states);
 
     const bool islands_enabled = islands.enabled();
     if (islands_enabled)
     {
         islands.remove_invalid_and_gather_awake();
+        joints.actuators.solve_contacts(states);
         islands.solve_actuators(states);
 
         bodies.integrate_velocities(timestep);
@@ -122,13 +160,19 @@ std::vector<float> world2D::operator()(const float time, const float timestep, c
     }
 
     bodies.integrate_positions(timestep);
+    joints.xpbd.solve(states, timestep);
+    if (joints.constraints.params.soft_step)
+    {
+        if (islands_enabled)
+            islands.relax_velocity_constraints();
+        else
+            joints.constraints.relax_velocities();
+    }
+
     if (islands_enabled)
-        islands.solve_position_constraints(states);
+        islands.solve_position_constraints();
     else
         joints.constraints.solve_positions(states);
-
-    m_rk_substep_index++;
-    return bodies.load_velocities_and_forces();
 }
 
 void world2D::post_step()
@@ -136,6 +180,7 @@ void world2D::post_step()
     KIT_PERF_SCOPE("ppx::world2D::post_step")
     if (!bodies.retrieve_data_from_states(integrator.state.vars()))
         colliders.update_bounding_boxes();
+    collisions.deliver_contact_events();
 
     KIT_ASSERT_ERROR(!islands.enabled() || islands.checksum(), "Island checkusm failed")
 #if defined(DEBUG) && !defined(_MSC_VER)
@@ -156,6 +201,8 @@ float world2D::rk_timestep() const
 }
 float world2D::substep_timestep() const
 {
+    if (joints.constraints.params.soft_step)
+        return integrator.ts.value / (float)std::max(joints.constraints.params.substeps, 1u);
     return integrator.ts.value / integrator.tableau().stages;
 }
 